@@ -0,0 +1,32 @@
+#ifndef HTTP_BODY_SOURCE_H
+#define HTTP_BODY_SOURCE_H
+
+#include <cstddef>
+#include <string_view>
+
+#include "Definitions.h"
+
+namespace Http {
+
+// Pull side of a response body. read() blocks until some data is available
+// and returns 0 once the whole body has been read.
+class EXPORT_HTTP BodySource {
+public:
+    virtual ~BodySource();
+
+    virtual size_t read(char* buffer, size_t size) = 0;
+};
+
+// A body that is already in memory, the view has to outlive the source.
+class EXPORT_HTTP StringBodySource : public BodySource {
+public:
+    StringBodySource(std::string_view body);
+
+    size_t read(char* buffer, size_t size) override;
+private:
+    std::string_view m_body;
+};
+
+}
+
+#endif
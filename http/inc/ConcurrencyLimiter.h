@@ -0,0 +1,76 @@
+#ifndef HTTP_CONCURRENCY_LIMITER_H
+#define HTTP_CONCURRENCY_LIMITER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+#include "Definitions.h"
+
+namespace Http {
+
+// AIMD limit on the number of requests in flight. While the smoothed
+// time-to-first-byte stays close to the lowest latency seen recently and the
+// limit is actually used, it grows by one per limit's worth of responses. A 429,
+// a 503, a network error or latency inflated past the tolerance shrinks it by
+// the backoff ratio, at most once per smoothed latency so that the responses of
+// one overloaded round trip count once.
+class EXPORT_HTTP ConcurrencyLimiter {
+public:
+    using Clock = std::chrono::steady_clock;
+    using Duration = std::chrono::microseconds;
+
+    ConcurrencyLimiter(size_t initialLimit = 8, size_t minLimit = 1, size_t maxLimit = 64);
+    ConcurrencyLimiter(const ConcurrencyLimiter&) = delete;
+    ConcurrencyLimiter& operator=(const ConcurrencyLimiter&) = delete;
+
+    // Blocks while the limit is reached.
+    void acquire();
+    // Takes a slot only when one is free right away.
+    bool tryAcquire();
+    // Gives back a slot taken for a request that was not sent after all,
+    // without counting it as a response.
+    void cancel();
+    // `status` is the response code, -1 for requests that failed without one.
+    void release(int status, Duration latency);
+
+    size_t limit() const;
+    size_t inFlight() const;
+
+    void setBackoffRatio(double ratio);
+    double backoffRatio() const;
+
+    // Smoothed latency above baseline * tolerance counts as the server queueing.
+    void setLatencyTolerance(double tolerance);
+    double latencyTolerance() const;
+
+    // The baseline is the lowest latency among this many samples, so it follows
+    // a server that got permanently slower instead of throttling forever.
+    void setBaselineWindow(size_t samples);
+    size_t baselineWindow() const;
+private:
+    void decrease(Clock::time_point now);
+
+    mutable std::mutex m_mutex{};
+    std::condition_variable m_available{};
+
+    double m_limit;
+    size_t m_minLimit;
+    size_t m_maxLimit;
+    size_t m_inFlight{0};
+
+    double m_backoffRatio{0.7};
+    double m_latencyTolerance{2.0};
+    size_t m_baselineWindow{256};
+
+    double m_smoothed{0};
+    size_t m_samples{0};
+    Duration m_baseline{Duration::max()};
+    Duration m_windowMin{Duration::max()};
+    size_t m_windowSamples{0};
+    Clock::time_point m_lastDecrease{};
+};
+
+}
+
+#endif
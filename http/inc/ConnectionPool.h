@@ -0,0 +1,91 @@
+#ifndef HTTP_CONNECTION_POOL_H
+#define HTTP_CONNECTION_POOL_H
+
+#include <array>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Definitions.h"
+
+namespace Socket{
+    class TCPSocket;
+}
+
+namespace Http {
+
+// Safe to share between threads: idle connections are spread over shards by
+// key, each guarded by its own mutex, which is never held while a socket is
+// probed or closed. The limits are expected to be set before the pool is used
+// concurrently.
+class EXPORT_HTTP ConnectionPool {
+public:
+    using SocketPtr = std::shared_ptr<Socket::TCPSocket>;
+    using Clock = std::chrono::steady_clock;
+
+    ConnectionPool();
+    ConnectionPool(const ConnectionPool& pool) = delete;
+    ConnectionPool(ConnectionPool&& pool);
+    ~ConnectionPool();
+
+    ConnectionPool& operator=(ConnectionPool&& pool);
+
+    // Returns the most recently used idle connection for the key that is still
+    // open on the peer side, or nullptr when a new one has to be established.
+    SocketPtr acquire(const std::string& key);
+    void release(const std::string& key, SocketPtr socket);
+
+    // Closes expired connections and those closed by the peer. Besides calls
+    // to it, acquire() evicts from the shard it looks into every half idle
+    // timeout, and the reaper when started.
+    void evictIdle();
+    void clear();
+    size_t idleCount() const;
+
+    void setIdleTimeout(std::chrono::seconds timeout);
+    std::chrono::seconds idleTimeout() const noexcept;
+
+    void setMaxIdlePerHost(size_t count);
+    size_t maxIdlePerHost() const noexcept;
+
+    // Runs evictIdle() every interval on a thread of its own until the reaper
+    // is stopped or the pool destroyed, restarting it changes the interval.
+    void startReaper(std::chrono::seconds interval);
+    void stopReaper();
+    bool reaperRunning() const noexcept;
+private:
+    struct PooledSocket {
+        SocketPtr socket;
+        Clock::time_point lastUsed;
+    };
+    using IdleSockets = std::vector<PooledSocket>;
+
+    struct Shard {
+        mutable std::mutex mutex{};
+        std::unordered_map<std::string, IdleSockets> idleSockets{};
+        Clock::time_point lastEviction{Clock::now()};
+    };
+
+    static const size_t SHARD_COUNT = 16;
+    using Shards = std::array<Shard, SHARD_COUNT>;
+
+    struct Reaper;
+
+    Shard& shardFor(const std::string& key);
+    bool isExpired(const PooledSocket& pooledSocket, Clock::time_point now) const;
+    void evictIdle(Shard& shard, Clock::time_point now);
+
+    std::unique_ptr<Shards> m_shards;
+    std::unique_ptr<Reaper> m_reaper;
+    std::chrono::seconds m_idleTimeout{30};
+    size_t m_maxIdlePerHost{8};
+
+    friend void swap(ConnectionPool& first, ConnectionPool& second);
+};
+
+}
+
+#endif
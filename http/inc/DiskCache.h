@@ -0,0 +1,88 @@
+#ifndef HTTP_DISK_CACHE_H
+#define HTTP_DISK_CACHE_H
+
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+
+#include "HttpCache.h"
+#include "MappedFile.h"
+
+namespace Http {
+
+// HttpCache persisted in a directory that has to exist already. Responses are
+// appended to numbered segment files and located through an open addressing
+// hash table kept in a memory mapped index file, so a restarted process finds
+// the cache warm. Once the segments exceed the capacity the oldest segment is
+// deleted together with every entry pointing into it. Keys are only stored as
+// their SHA-256 and, outside Windows, every file is readable by the owner only.
+class EXPORT_HTTP DiskCache : public HttpCache {
+public:
+    DiskCache(const std::string& directory,
+              uint64_t capacity = 1024ull * 1024 * 1024,
+              uint64_t segmentSize = 64ull * 1024 * 1024,
+              uint64_t slotCount = 1 << 16);
+    DiskCache(const DiskCache&) = delete;
+    ~DiskCache() override;
+
+    DiskCache& operator=(const DiskCache&) = delete;
+
+    EntryPtr lookup(const std::string& key) override;
+    void store(const std::string& key, EntryPtr entry) override;
+    void remove(const std::string& key) override;
+    void clear() override;
+
+    uint64_t entryCount() const;
+private:
+    struct IndexHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t slotCount;
+        uint64_t firstSegment;
+        uint64_t lastSegment;
+        uint64_t liveCount;
+        uint64_t usedCount;
+    };
+
+    struct IndexSlot {
+        uint64_t hash;
+        uint64_t segment;
+        uint64_t offset;
+        uint64_t length;
+    };
+
+    struct RecordHeader {
+        uint32_t magic;
+        uint32_t keyLength;
+        uint64_t responseLength;
+        int64_t responseTime;
+    };
+
+    static uint64_t hash(const std::string& key) noexcept;
+
+    IndexHeader& header() noexcept;
+    IndexSlot* slots() noexcept;
+    IndexSlot* findSlot(uint64_t hash) noexcept;
+    void insertSlot(const IndexSlot& slot);
+    void rebuildIndex();
+
+    std::string segmentPath(uint64_t segment) const;
+    void openWriter();
+    void rotateSegment();
+    void evictSegment(uint64_t segment);
+    void reset();
+
+    std::string m_directory;
+    uint64_t m_maxSegments;
+    uint64_t m_segmentSize;
+    uint64_t m_slotCount;
+
+    mutable std::mutex m_mutex{};
+    MappedFile m_index{};
+    std::ofstream m_writer{};
+    uint64_t m_writerOffset{0};
+};
+
+}
+
+#endif
@@ -0,0 +1,18 @@
+#ifndef HTTP_FAN_OUT_H
+#define HTTP_FAN_OUT_H
+
+#include <cstddef>
+#include <functional>
+
+#include "Definitions.h"
+
+namespace Http {
+
+// Calls task(i) for every i below count on up to `concurrency` threads, the
+// calling one included. Once a task throws no further indices are handed out,
+// the remaining workers are joined and the first exception is rethrown.
+EXPORT_HTTP void fanOut(size_t count, size_t concurrency, const std::function<void(size_t)>& task);
+
+}
+
+#endif
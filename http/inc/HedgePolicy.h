@@ -0,0 +1,66 @@
+#ifndef HTTP_HEDGE_POLICY_H
+#define HTTP_HEDGE_POLICY_H
+
+#include <chrono>
+#include <vector>
+
+#include "Definitions.h"
+
+namespace Http {
+
+class EXPORT_HTTP LatencyWindow {
+public:
+    using Duration = std::chrono::milliseconds;
+
+    LatencyWindow(size_t capacity = 256);
+
+    void add(Duration latency);
+    Duration percentile(double percentile) const;
+    size_t size() const noexcept;
+private:
+    std::vector<Duration> m_samples;
+    size_t m_capacity;
+    size_t m_next{0};
+};
+
+class EXPORT_HTTP HedgePolicy {
+public:
+    using Duration = std::chrono::milliseconds;
+
+    HedgePolicy();
+    HedgePolicy(double percentile, Duration minDelay, Duration maxDelay);
+
+    void setEnabled(bool enabled);
+    bool enabled() const noexcept;
+
+    // The second request fires once the first has waited longer than this
+    // percentile of recent time-to-first-byte samples for the host.
+    void setPercentile(double percentile);
+    double percentile() const noexcept;
+
+    void setMinDelay(Duration delay);
+    Duration minDelay() const noexcept;
+
+    void setMaxDelay(Duration delay);
+    Duration maxDelay() const noexcept;
+
+    // Used until the host has enough samples for a meaningful percentile.
+    void setInitialDelay(Duration delay);
+    Duration initialDelay() const noexcept;
+
+    void setMinSamples(size_t count);
+    size_t minSamples() const noexcept;
+
+    Duration delay(const LatencyWindow& window) const;
+private:
+    bool m_enabled{false};
+    double m_percentile{0.95};
+    Duration m_minDelay{20};
+    Duration m_maxDelay{2000};
+    Duration m_initialDelay{500};
+    size_t m_minSamples{20};
+};
+
+}
+
+#endif
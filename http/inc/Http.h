@@ -1,6 +1,7 @@
 #ifndef HTTP_DEFINITIONS
 #define HTTP_DEFINITIONS
 
+#include <ctime>
 #include <string>
 #include <vector>
 #include "Definitions.h"
@@ -17,11 +18,13 @@ enum class Method {
 
 enum class Header {
     UNKNOWN = -1, CONTENT_LENGTH = 0, CONTENT_TYPE = 1, USER_AGENT = 2, CONNECTION = 3, HOST = 4, ACCEPT = 5, CACHE_CONTROL = 6, SET_COOKIE = 7,
-    CONTENT_LANGUAGE = 8, EXPIRES = 9, ACCEPT_ENCODING = 10, ACCEPT_LANGUAGE = 11, COOKIE  = 12, TRANSFER_ENCODING = 13, LOCATION = 14
+    CONTENT_LANGUAGE = 8, EXPIRES = 9, ACCEPT_ENCODING = 10, ACCEPT_LANGUAGE = 11, COOKIE  = 12, TRANSFER_ENCODING = 13, LOCATION = 14,
+    RETRY_AFTER = 15, ETAG = 16, IF_NONE_MATCH = 17, LAST_MODIFIED = 18, IF_MODIFIED_SINCE = 19, DATE = 20, AGE = 21
 };
 
 enum  Status {
-    UNKNOWN = -1, OK = 200, MOVED = 302, BAD_REQUEST = 400, UNAUTHORIZED = 401, FORBIDDEN = 403, NOT_FOUND = 404, INTERNAL_SERVER_ERROR = 500
+    UNKNOWN = -1, OK = 200, MOVED = 302, NOT_MODIFIED = 304, BAD_REQUEST = 400, UNAUTHORIZED = 401, FORBIDDEN = 403, NOT_FOUND = 404, TOO_MANY_REQUESTS = 429,
+    INTERNAL_SERVER_ERROR = 500, BAD_GATEWAY = 502, SERVICE_UNAVAILABLE = 503, GATEWAY_TIMEOUT = 504
 };
 
 const char* toString(Method method) noexcept;
@@ -29,12 +32,20 @@ const char* toString(Header header) noexcept;
 const char* toString(Status status) noexcept;
 const char* toString(HttpProtocol protocol) noexcept;
 
+// Status::UNKNOWN for codes without an enumerator.
+Status from_int(int status);
+
 std::string changeCase(const char* str, bool to_upper = false);
 std::string changeCase(const std::string& str, bool to_upper = false);
 
 Method fromStr(const char* str);
 Method fromStr(const std::string& str);
 
+bool isIdempotent(Method method) noexcept;
+
+// IMF-fixdate as used by Date, Expires and Retry-After, -1 if it cannot be parsed.
+std::time_t parseHttpDate(const std::string& date);
+
 std::vector<std::string> split(const std::string &str, const char delimeter, bool once = false);
 
 }
@@ -0,0 +1,52 @@
+#ifndef HTTP_CACHE_H
+#define HTTP_CACHE_H
+
+#include <ctime>
+#include <memory>
+#include <string>
+
+#include "HttpResponse.h"
+
+namespace Http {
+
+struct EXPORT_HTTP CacheControl {
+    static CacheControl parse(const std::string& value);
+
+    bool noStore{false};
+    bool noCache{false};
+    long maxAge{-1};
+};
+
+// A stored response together with what RFC 7234 needs to judge its freshness.
+struct EXPORT_HTTP CacheEntry {
+    // Responses with mapped bodies, no-store or neither a freshness lifetime
+    // nor a validator are not worth keeping and yield nullptr.
+    static std::shared_ptr<const CacheEntry> create(const HttpResponse& response, std::time_t responseTime);
+
+    bool isFresh(std::time_t now) const noexcept;
+    bool hasValidator() const noexcept;
+    std::time_t age(std::time_t now) const noexcept;
+
+    HttpResponse response{};
+    std::time_t responseTime{0};
+    std::time_t initialAge{0};
+    std::time_t freshnessLifetime{0};
+    bool alwaysRevalidate{false};
+    size_t size{0};
+};
+
+class EXPORT_HTTP HttpCache {
+public:
+    using EntryPtr = std::shared_ptr<const CacheEntry>;
+
+    virtual ~HttpCache();
+
+    virtual EntryPtr lookup(const std::string& key) = 0;
+    virtual void store(const std::string& key, EntryPtr entry) = 0;
+    virtual void remove(const std::string& key) = 0;
+    virtual void clear() = 0;
+};
+
+}
+
+#endif
@@ -5,14 +5,24 @@
 #ifndef FOLLOGRAPH_HTTPSOCKET_H
 #define FOLLOGRAPH_HTTPSOCKET_H
 
+#include <chrono>
+#include <functional>
+#include <limits>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
+#include <vector>
 
 #include "Http.h"
-
-namespace Socket{
-    class TCPSocket;
-}
+#include "BodySource.h"
+#include "ConcurrencyLimiter.h"
+#include "ConnectionPool.h"
+#include "HedgePolicy.h"
+#include "HttpCache.h"
+#include "Metrics.h"
+#include "RequestThrottle.h"
+#include "RequestTimings.h"
+#include "RetryPolicy.h"
 
 namespace Http {
 
@@ -21,8 +31,12 @@ class HttpRequest;
 class HttpResponse;
 class HttpUrl;
 
+// One client can be shared by any number of threads. Configuration setters are
+// not synchronized and belong before the client is handed to other threads.
 class EXPORT_HTTP HttpClient {
 public:
+    using BodyReader = std::function<void(const HttpResponse& response, BodySource& body)>;
+
     HttpClient();
     HttpClient(HttpClient&) = delete;
     HttpClient(HttpClient&& http_socket);
@@ -36,25 +50,115 @@ public:
     HttpResponse post(const HttpUrl& url, const FormData& form_data);
     HttpResponse del(const HttpUrl& url);
 
+    // Same as get, but when the hedge policy is enabled a second identical
+    // request is issued on another connection if the first one is slow to
+    // answer, the response that starts arriving first is returned.
+    HttpResponse hedgedGet(const HttpUrl& url);
+
+    // Hands the body of a 2xx response to the reader while it is still
+    // arriving instead of buffering it, the returned response then has an
+    // empty body. Other responses come back buffered without calling the
+    // reader. Attempts are retried until the reader has been called, never
+    // after. With a cache set the body is buffered anyway so it can be stored,
+    // and the reader gets it from memory.
+    HttpResponse getStreamed(const HttpUrl& url, const BodyReader& reader);
+
+    // Requests are spread over up to `concurrency` threads, each on its own
+    // pooled connection, responses come back in the order of the requests.
+    // When a request throws the rest are not sent and the first exception is
+    // rethrown once every thread has stopped.
+    std::vector<HttpResponse> sendBatch(const std::vector<HttpRequest>& httpRequests, size_t concurrency = 8);
+    std::vector<HttpResponse> getBatch(const std::vector<HttpUrl>& urls, size_t concurrency = 8);
+
     HttpResponse sendRequest(const HttpRequest& httpRequest);
     HttpResponse operator<<(const HttpRequest& httpRequest);
     HttpResponse operator<<(const HttpUrl& url);
 
-private:
-    HttpRequest getDefaultRequest() const;
-    void send(const HttpRequest& httpRequest);
+    // Bodies with a Content-Length above this limit are spilled to a temporary
+    // mapped file instead of the heap, 0 keeps every body in memory.
+    void setMaxBodyInMemory(size_t bytes);
+    size_t maxBodyInMemory() const noexcept;
 
-    HttpResponse receive(const HttpUrl& url, unsigned int timeout);
-    std::string read(const HttpUrl& url, unsigned int timeout);
-    std::string read_until(size_t len, long timeout);
+    void setMaxResponseSize(size_t bytes);
+    size_t maxResponseSize() const noexcept;
 
-    using SocketPtr = std::shared_ptr<Socket::TCPSocket>;
-    SocketPtr getSocket(const HttpUrl& url);
-    SocketPtr connect(const HttpUrl& url);
-    void disconnect(const HttpUrl& url);
+    // Pooled keep-alive connections idle for longer than this are closed
+    // instead of reused.
+    void setIdleTimeout(std::chrono::seconds timeout);
+    std::chrono::seconds idleTimeout() const noexcept;
+    void evictIdleConnections();
+
+    // Evicts stale pooled connections in the background every interval, 0 (the
+    // default) leaves them to be evicted as requests come across them.
+    void setEvictionInterval(std::chrono::seconds interval);
+
+    // Applied by sendRequest, by default idempotent requests are attempted up to
+    // three times on network errors and 429/502/503/504 responses.
+    void setRetryPolicy(const RetryPolicy& retryPolicy);
+    const RetryPolicy& retryPolicy() const noexcept;
+
+    void setHedgePolicy(const HedgePolicy& hedgePolicy);
+    const HedgePolicy& hedgePolicy() const noexcept;
 
-    using HostToSocketMap = std::unordered_map<std::string, SocketPtr>;
-    HostToSocketMap m_hostToSocketMap{};
+    // Observers see every attempt made by sendRequest together with its phase
+    // timings, the same timings are also available on the returned response.
+    void addObserver(std::shared_ptr<RequestObserver> observer);
+    void removeObserver(const std::shared_ptr<RequestObserver>& observer);
+
+    // Registers the registry as an observer, replacing a previously set one.
+    void setMetrics(std::shared_ptr<MetricsRegistry> metrics);
+    const std::shared_ptr<MetricsRegistry>& metrics() const noexcept;
+
+    // GET responses are served from the cache while fresh and revalidated with
+    // their ETag or Last-Modified once stale. Other methods invalidate the url.
+    void setCache(std::shared_ptr<HttpCache> cache);
+    const std::shared_ptr<HttpCache>& cache() const noexcept;
+
+    // Every network attempt waits for a slot of the limiter, which may be shared
+    // by several clients talking to the same service. Cache hits do not count.
+    void setConcurrencyLimiter(std::shared_ptr<ConcurrencyLimiter> limiter);
+    const std::shared_ptr<ConcurrencyLimiter>& concurrencyLimiter() const noexcept;
+
+    // Waited on before the limiter, a request held back does not take a slot.
+    void setThrottle(std::shared_ptr<RequestThrottle> throttle);
+    const std::shared_ptr<RequestThrottle>& throttle() const noexcept;
+
+private:
+    using SocketPtr = ConnectionPool::SocketPtr;
+
+    HttpRequest getDefaultRequest() const;
+    HttpResponse sendRequest(const HttpRequest& httpRequest, bool hedged);
+    HttpResponse sendCached(const HttpRequest& httpRequest, bool hedged);
+    HttpResponse sendWithRetries(const HttpRequest& httpRequest, bool hedged, const BodyReader* reader = nullptr);
+    HttpResponse execute(const HttpRequest& httpRequest, bool hedged, RequestTimings& timings, const BodyReader* reader);
+    HttpResponse exchange(SocketPtr& socket, const std::string& key, const HttpRequest& httpRequest, bool hedged, RequestTimings& timings, const BodyReader* reader);
+    SocketPtr sendHedge(const std::string& key, const HttpRequest& httpRequest);
+    HedgePolicy::Duration hedgeDelay(const std::string& key);
+    void recordFirstByte(const std::string& key, LatencyWindow::Duration latency);
+    size_t send(const SocketPtr& socket, const HttpRequest& httpRequest);
+
+    HttpResponse receive(const SocketPtr& socket, unsigned int timeout, RequestTimings& timings, const BodyReader* reader);
+    void receiveToFile(const SocketPtr& socket, unsigned int timeout, HttpResponse& httpResponse, size_t contentLen);
+    std::string read(const SocketPtr& socket, unsigned int timeout);
+    std::string readAvailable(const SocketPtr& socket);
+
+    static std::string poolKey(const HttpUrl& url);
+    SocketPtr connect(const HttpUrl& url);
+    void notifyObservers(const HttpRequest& httpRequest, const HttpResponse& httpResponse);
+
+    ConnectionPool m_connectionPool{};
+    RetryPolicy m_retryPolicy{};
+    HedgePolicy m_hedgePolicy{};
+    std::unordered_map<std::string, LatencyWindow> m_firstByteLatency{};
+    std::mutex m_latencyMutex{};
+    std::vector<std::shared_ptr<RequestObserver>> m_observers{};
+    std::shared_ptr<MetricsRegistry> m_metrics{};
+    std::shared_ptr<HttpCache> m_cache{};
+    std::shared_ptr<ConcurrencyLimiter> m_limiter{};
+    std::shared_ptr<RequestThrottle> m_throttle{};
+
+    size_t m_maxBodyInMemory{0};
+    size_t m_maxResponseSize{std::numeric_limits<unsigned int>::max()};
 
     EXPORT_HTTP friend void swap(HttpClient& first, HttpClient& second);
 };
@@ -3,6 +3,7 @@
 
 #include <unordered_map>
 #include <memory>
+#include <string_view>
 #include "Http.h"
 
 namespace Http {
@@ -29,7 +30,11 @@ public:
     void appendBody(const std::string& _body);
     void appendBody(const char* _body);
     void appendBody(const char *_body, const size_t len);
+    void reserveBody(size_t capacity);
     size_t bodySize() const noexcept;
+    virtual std::string_view bodyView() const noexcept;
+    // Moves the body out without copying it, the body is empty afterwards.
+    virtual std::string takeBody();
 
     bool isContainsHeader(Header header) const noexcept;
     size_t contentLen() const;
@@ -2,10 +2,12 @@
 #define HTTP_RESPONSE_HEADER
 
 #include "HttpHeader.h"
+#include "RequestTimings.h"
 
 namespace Http {
     
 class HttpClient;    
+class MappedFile;
 
 class EXPORT_HTTP HttpResponse : public HttpHeader {
 public:
@@ -25,16 +27,32 @@ public:
     void setStatus(Http::Status status);
     void setStatus(const std::string& status, int code);
 
+    // Bodies over HttpClient's in-memory limit live in a temporary mapped file
+    // and are only reachable through bodyView(), body() stays empty for them.
+    bool isBodyMapped() const noexcept;
+    std::string_view bodyView() const noexcept override;
+    // A mapped body has to be copied out of its file.
+    std::string takeBody() override;
+
+    // Filled in by HttpClient for the attempt that produced this response.
+    const RequestTimings& timings() const noexcept;
+
     std::string getString() const override;
 private:
     friend class HttpClient;
 
     HttpResponse(const std::string& response);
     void parseResponse(const std::string& response);
+    void setMappedBody(std::shared_ptr<MappedFile> mappedBody, size_t size);
     
     std::string m_status{};
     int m_code{-1};
 
+    std::shared_ptr<MappedFile> m_mappedBody{};
+    size_t m_mappedBodySize{0};
+
+    RequestTimings m_timings{};
+
     friend void swap(HttpResponse& first, HttpResponse& second);
 };
 
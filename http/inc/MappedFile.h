@@ -0,0 +1,51 @@
+#ifndef HTTP_MAPPED_FILE_H
+#define HTTP_MAPPED_FILE_H
+
+#include <string>
+#include "Definitions.h"
+
+namespace Http {
+
+class EXPORT_HTTP MappedFile {
+public:
+    MappedFile();
+    MappedFile(const std::string& path, size_t size);
+    MappedFile(const MappedFile& mappedFile) = delete;
+    MappedFile(MappedFile&& mappedFile);
+    ~MappedFile();
+
+    MappedFile& operator=(const MappedFile& mappedFile) = delete;
+    MappedFile& operator=(MappedFile&& mappedFile);
+
+    // Unnamed file in the temp directory, removed from disk as soon as it is created.
+    static MappedFile temporary(size_t size);
+
+    char* data() noexcept;
+    const char* data() const noexcept;
+    size_t size() const noexcept;
+    bool isOpen() const noexcept;
+
+    void sync();
+    void close();
+private:
+    void open(const std::string& path, size_t size, bool removeAfterMap);
+#ifndef _WIN32
+    void map(const std::string& path, size_t size);
+#endif
+
+    char* m_data{nullptr};
+    size_t m_size{0};
+
+#ifdef _WIN32
+    void* m_file{nullptr};
+    void* m_mapping{nullptr};
+#else
+    int m_fd{-1};
+#endif
+
+    friend void swap(MappedFile& first, MappedFile& second);
+};
+
+}
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef HTTP_MEMORY_CACHE_H
+#define HTTP_MEMORY_CACHE_H
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+#include "HttpCache.h"
+
+namespace Http {
+
+// In-memory HttpCache evicting least recently used entries once the stored
+// responses exceed the byte budget.
+class EXPORT_HTTP MemoryCache : public HttpCache {
+public:
+    MemoryCache(size_t capacity = 16 * 1024 * 1024);
+    ~MemoryCache() override;
+
+    EntryPtr lookup(const std::string& key) override;
+    void store(const std::string& key, EntryPtr entry) override;
+    void remove(const std::string& key) override;
+    void clear() override;
+
+    size_t size() const;
+    size_t capacity() const noexcept;
+private:
+    using LruList = std::list<std::pair<std::string, EntryPtr>>;
+
+    void erase(LruList::iterator it);
+
+    mutable std::mutex m_mutex{};
+    LruList m_lru{};
+    std::unordered_map<std::string, LruList::iterator> m_entries{};
+    size_t m_size{0};
+    size_t m_capacity;
+};
+
+}
+
+#endif
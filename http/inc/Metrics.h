@@ -0,0 +1,119 @@
+#ifndef HTTP_METRICS_H
+#define HTTP_METRICS_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "RequestTimings.h"
+
+namespace Http {
+
+// Log-linear histogram of microsecond latencies: every power of two is split
+// into eight buckets, so any recorded value is off by at most 12.5%. Recording
+// only touches relaxed atomics.
+class EXPORT_HTTP LatencyHistogram {
+public:
+    using Duration = std::chrono::microseconds;
+
+    static const size_t SUB_BUCKET_BITS = 3;
+    static const size_t SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static const size_t BUCKETS = 40 * SUB_BUCKETS;
+
+    LatencyHistogram();
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    void record(Duration latency) noexcept;
+
+    uint64_t count() const noexcept;
+    Duration sum() const noexcept;
+    Duration percentile(double percentile) const noexcept;
+
+    // Number of recorded values not greater than the given bound.
+    uint64_t countAtMost(Duration bound) const noexcept;
+
+    static size_t bucketIndex(uint64_t value) noexcept;
+    static uint64_t bucketUpperBound(size_t index) noexcept;
+private:
+    std::array<std::atomic<uint64_t>, BUCKETS> m_buckets;
+    std::atomic<uint64_t> m_count{0};
+    std::atomic<uint64_t> m_sum{0};
+};
+
+class EXPORT_HTTP EndpointMetrics {
+public:
+    static const int MAX_STATUS = 600;
+
+    EndpointMetrics();
+    EndpointMetrics(const EndpointMetrics&) = delete;
+    EndpointMetrics& operator=(const EndpointMetrics&) = delete;
+
+    void record(const HttpResponse& response, const RequestTimings& timings) noexcept;
+
+    LatencyHistogram latency{};
+    LatencyHistogram timeToFirstByte{};
+
+    std::atomic<uint64_t> requests{0};
+    std::atomic<uint64_t> networkErrors{0};
+    std::atomic<uint64_t> connectionsOpened{0};
+    std::atomic<uint64_t> bytesSent{0};
+    std::atomic<uint64_t> bytesReceived{0};
+    std::array<std::atomic<uint64_t>, MAX_STATUS> statuses;
+};
+
+struct EXPORT_HTTP MetricsSnapshot {
+    std::string host{};
+    std::string endpoint{};
+
+    uint64_t requests{0};
+    uint64_t networkErrors{0};
+    uint64_t connectionsOpened{0};
+    uint64_t bytesSent{0};
+    uint64_t bytesReceived{0};
+    std::map<int, uint64_t> statuses{};
+
+    LatencyHistogram::Duration p50{0};
+    LatencyHistogram::Duration p90{0};
+    LatencyHistogram::Duration p99{0};
+};
+
+// Request observer aggregating counters and latency histograms per host and
+// per endpoint. Numeric path segments are collapsed so /users/123 and
+// /users/456 share one series, so are tag names and media shortcodes.
+class EXPORT_HTTP MetricsRegistry : public RequestObserver {
+public:
+    MetricsRegistry();
+    ~MetricsRegistry() override;
+
+    void onResponse(const HttpRequest& request, const HttpResponse& response, const RequestTimings& timings) override;
+
+    std::vector<MetricsSnapshot> hostSnapshot() const;
+    std::vector<MetricsSnapshot> endpointSnapshot() const;
+
+    // Prometheus text exposition format.
+    std::string exportText() const;
+
+    static std::string normalizeEndpoint(const std::string& endpoint);
+private:
+    using MetricsMap = std::unordered_map<std::string, std::unique_ptr<EndpointMetrics>>;
+
+    EndpointMetrics& metricsFor(MetricsMap& metrics, const std::string& key);
+    std::vector<MetricsSnapshot> snapshot(const MetricsMap& metrics) const;
+    void exportMetrics(std::string& out, const MetricsMap& metrics, const std::string& prefix) const;
+
+    mutable std::shared_mutex m_mutex{};
+    MetricsMap m_hosts{};
+    MetricsMap m_endpoints{};
+};
+
+}
+
+#endif
@@ -0,0 +1,26 @@
+#ifndef HTTP_REQUEST_THROTTLE_H
+#define HTTP_REQUEST_THROTTLE_H
+
+#include "Definitions.h"
+
+namespace Http {
+
+class HttpRequest;
+
+// Consulted by HttpClient before every network attempt, wait() blocks for as
+// long as the request has to be held back.
+class EXPORT_HTTP RequestThrottle {
+public:
+    virtual ~RequestThrottle();
+
+    virtual void wait(const HttpRequest& request) = 0;
+
+    // For requests that are dropped rather than delayed, hedges: counts the
+    // request and returns true when it may go right away, false otherwise.
+    // The default lets every request through.
+    virtual bool tryPass(const HttpRequest& request);
+};
+
+}
+
+#endif
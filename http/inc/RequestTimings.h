@@ -0,0 +1,56 @@
+#ifndef HTTP_REQUEST_TIMINGS_H
+#define HTTP_REQUEST_TIMINGS_H
+
+#include <chrono>
+
+#include "Definitions.h"
+
+namespace Http {
+
+class HttpRequest;
+class HttpResponse;
+
+// Monotonic timestamps of a single request attempt. Phases that did not happen,
+// like DNS, connect and TLS on a reused connection, keep a default-constructed
+// time point and report a zero duration.
+struct EXPORT_HTTP RequestTimings {
+    using Clock = std::chrono::steady_clock;
+    using Duration = std::chrono::microseconds;
+
+    Clock::time_point start{};
+    Clock::time_point dnsStart{};
+    Clock::time_point dnsEnd{};
+    Clock::time_point connectEnd{};
+    Clock::time_point tlsEnd{};
+    Clock::time_point requestSent{};
+    Clock::time_point firstByte{};
+    Clock::time_point lastByte{};
+
+    size_t bytesSent{0};
+    size_t bytesReceived{0};
+
+    unsigned int attempt{1};
+    bool reusedConnection{false};
+    bool hedged{false};
+    bool cached{false};
+
+    Duration dns() const noexcept;
+    Duration connect() const noexcept;
+    Duration tls() const noexcept;
+    Duration timeToFirstByte() const noexcept;
+    Duration transfer() const noexcept;
+    Duration total() const noexcept;
+};
+
+// Notified by HttpClient after every attempt, including failed ones whose
+// response carries code -1 and the error in its status.
+class EXPORT_HTTP RequestObserver {
+public:
+    virtual ~RequestObserver();
+
+    virtual void onResponse(const HttpRequest& request, const HttpResponse& response, const RequestTimings& timings) = 0;
+};
+
+}
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef HTTP_RETRY_POLICY_H
+#define HTTP_RETRY_POLICY_H
+
+#include <chrono>
+#include <set>
+
+#include "Http.h"
+
+namespace Http {
+
+class HttpRequest;
+class HttpResponse;
+
+class EXPORT_HTTP RetryPolicy {
+public:
+    using Duration = std::chrono::milliseconds;
+
+    RetryPolicy();
+    RetryPolicy(unsigned int maxAttempts, Duration baseDelay, Duration maxDelay);
+
+    static RetryPolicy disabled();
+
+    void setMaxAttempts(unsigned int attempts);
+    unsigned int maxAttempts() const noexcept;
+
+    void setBaseDelay(Duration delay);
+    Duration baseDelay() const noexcept;
+
+    void setMaxDelay(Duration delay);
+    Duration maxDelay() const noexcept;
+
+    void setRetryableStatuses(const std::set<int>& statuses);
+    const std::set<int>& retryableStatuses() const noexcept;
+
+    void setRetryOnNetworkError(bool retry);
+    bool retryOnNetworkError() const noexcept;
+
+    void setHonorRetryAfter(bool honor);
+    bool honorRetryAfter() const noexcept;
+
+    // Non-idempotent requests are never repeated unless this is turned off.
+    void setIdempotentOnly(bool idempotentOnly);
+    bool idempotentOnly() const noexcept;
+
+    bool shouldRetry(const HttpRequest& request, const HttpResponse& response, bool networkError, unsigned int attempt) const;
+
+    // Decorrelated jitter: a random delay between the base delay and three times
+    // the previous one, capped by the max delay. Retry-After wins when present.
+    Duration nextDelay(const HttpResponse& response, Duration previous) const;
+private:
+    Duration retryAfter(const HttpResponse& response) const;
+    Duration clampDelay(long long seconds) const;
+
+    unsigned int m_maxAttempts{3};
+    Duration m_baseDelay{100};
+    Duration m_maxDelay{10000};
+    std::set<int> m_retryableStatuses{429, 502, 503, 504};
+    bool m_retryOnNetworkError{true};
+    bool m_honorRetryAfter{true};
+    bool m_idempotentOnly{true};
+};
+
+}
+
+#endif
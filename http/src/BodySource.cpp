@@ -0,0 +1,19 @@
+#include <algorithm>
+#include <cstring>
+
+#include "BodySource.h"
+
+namespace Http {
+
+BodySource::~BodySource() {}
+
+StringBodySource::StringBodySource(std::string_view body) : m_body{body} {}
+
+size_t StringBodySource::read(char* buffer, size_t size) {
+    const size_t count = std::min(size, m_body.size());
+    std::memcpy(buffer, m_body.data(), count);
+    m_body.remove_prefix(count);
+    return count;
+}
+
+}
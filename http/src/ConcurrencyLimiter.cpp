@@ -0,0 +1,132 @@
+#include <algorithm>
+#include <cmath>
+
+#include "ConcurrencyLimiter.h"
+
+namespace Http {
+
+static const double SMOOTHING = 0.1;
+
+ConcurrencyLimiter::ConcurrencyLimiter(size_t initialLimit, size_t minLimit, size_t maxLimit) :
+    m_minLimit{std::max<size_t>(minLimit, 1)},
+    m_maxLimit{std::max(maxLimit, std::max<size_t>(minLimit, 1))} {
+    m_limit = static_cast<double>(std::clamp(initialLimit, m_minLimit, m_maxLimit));
+}
+
+void ConcurrencyLimiter::acquire() {
+    std::unique_lock<std::mutex> lock{m_mutex};
+    m_available.wait(lock, [this]() {
+        return static_cast<double>(m_inFlight) < std::floor(m_limit);
+    });
+    ++m_inFlight;
+}
+
+bool ConcurrencyLimiter::tryAcquire() {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    if (static_cast<double>(m_inFlight) >= std::floor(m_limit)) {
+        return false;
+    }
+    ++m_inFlight;
+    return true;
+}
+
+void ConcurrencyLimiter::cancel() {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    --m_inFlight;
+    m_available.notify_all();
+}
+
+void ConcurrencyLimiter::release(int status, Duration latency) {
+    const Clock::time_point now = Clock::now();
+
+    std::lock_guard<std::mutex> lock{m_mutex};
+    const size_t inFlight = m_inFlight--;
+    m_available.notify_all();
+
+    if (status < 0 || status == 429 || status == 503) {
+        decrease(now);
+        return;
+    }
+
+    if (latency <= Duration{0}) {
+        return;
+    }
+
+    // a plain mean until there are enough samples for the moving average
+    // to stand for more than the first few responses
+    const double weight = std::max(1.0 / static_cast<double>(++m_samples), SMOOTHING);
+    m_smoothed += (static_cast<double>(latency.count()) - m_smoothed) * weight;
+    if (weight > SMOOTHING) {
+        return;
+    }
+
+    // the minimum of the smoothed rather than the raw latency, a single
+    // lucky sample would otherwise make everything after it look inflated
+    const Duration smoothed{static_cast<Duration::rep>(m_smoothed)};
+    m_windowMin = std::min(m_windowMin, smoothed);
+    if (++m_windowSamples >= m_baselineWindow) {
+        m_baseline = m_windowMin;
+        m_windowMin = Duration::max();
+        m_windowSamples = 0;
+    }
+    m_baseline = std::min(m_baseline, smoothed);
+
+    if (m_smoothed > static_cast<double>(m_baseline.count()) * m_latencyTolerance) {
+        decrease(now);
+    } else if (static_cast<double>(inFlight) * 2 >= m_limit) {
+        // a limit the caller never comes close to says nothing about capacity
+        m_limit = std::min(m_limit + 1 / m_limit, static_cast<double>(m_maxLimit));
+    }
+}
+
+size_t ConcurrencyLimiter::limit() const {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    return static_cast<size_t>(m_limit);
+}
+
+size_t ConcurrencyLimiter::inFlight() const {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    return m_inFlight;
+}
+
+void ConcurrencyLimiter::setBackoffRatio(double ratio) {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    m_backoffRatio = std::clamp(ratio, 0.1, 1.0);
+}
+
+double ConcurrencyLimiter::backoffRatio() const {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    return m_backoffRatio;
+}
+
+void ConcurrencyLimiter::setLatencyTolerance(double tolerance) {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    m_latencyTolerance = std::max(tolerance, 1.0);
+}
+
+double ConcurrencyLimiter::latencyTolerance() const {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    return m_latencyTolerance;
+}
+
+void ConcurrencyLimiter::setBaselineWindow(size_t samples) {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    m_baselineWindow = std::max<size_t>(samples, 1);
+}
+
+size_t ConcurrencyLimiter::baselineWindow() const {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    return m_baselineWindow;
+}
+
+void ConcurrencyLimiter::decrease(Clock::time_point now) {
+    const Duration cooldown{static_cast<Duration::rep>(m_smoothed)};
+    if (m_lastDecrease != Clock::time_point{} && now - m_lastDecrease < cooldown) {
+        return;
+    }
+
+    m_limit = std::max(m_limit * m_backoffRatio, static_cast<double>(m_minLimit));
+    m_lastDecrease = now;
+}
+
+}
@@ -0,0 +1,259 @@
+#include <algorithm>
+#include <condition_variable>
+#include <thread>
+
+#include "TCPSocket.h"
+#include "ConnectionPool.h"
+
+namespace Http {
+
+// The thread evicts with the mutex held, which keeps the pool from being
+// swapped under it.
+struct ConnectionPool::Reaper {
+    std::mutex mutex{};
+    std::condition_variable wake{};
+    bool stopped{false};
+    ConnectionPool* pool{nullptr};
+    std::thread thread{};
+};
+
+ConnectionPool::ConnectionPool() : m_shards{std::make_unique<Shards>()} {
+    for (Shard& shard : *m_shards) {
+        shard.idleSockets.max_load_factor(0.75);
+    }
+}
+
+ConnectionPool::ConnectionPool(ConnectionPool&& pool) : ConnectionPool{} {
+    swap(*this, pool);
+}
+
+ConnectionPool::~ConnectionPool() {
+    stopReaper();
+}
+
+ConnectionPool& ConnectionPool::operator=(ConnectionPool&& pool) {
+    swap(*this, pool);
+
+    ConnectionPool temp{};
+    swap(pool, temp);
+    return *this;
+}
+
+ConnectionPool::SocketPtr ConnectionPool::acquire(const std::string& key) {
+    Shard& shard = shardFor(key);
+    const Clock::time_point now = Clock::now();
+
+    bool evict = false;
+    {
+        // only the first caller to notice evicts
+        std::lock_guard<std::mutex> lock{shard.mutex};
+        if (now - shard.lastEviction > m_idleTimeout / 2) {
+            shard.lastEviction = now;
+            evict = true;
+        }
+    }
+    if (evict) {
+        evictIdle(shard, now);
+    }
+
+    for (;;) {
+        PooledSocket pooledSocket{};
+        {
+            std::lock_guard<std::mutex> lock{shard.mutex};
+            auto it = shard.idleSockets.find(key);
+            if (it == shard.idleSockets.end() || it->second.empty()) {
+                return nullptr;
+            }
+
+            pooledSocket = std::move(it->second.back());
+            it->second.pop_back();
+        }
+
+        // the liveness probe is a syscall, other threads need not wait for it
+        if (!isExpired(pooledSocket, now) && pooledSocket.socket->isAlive()) {
+            return pooledSocket.socket;
+        }
+    }
+}
+
+void ConnectionPool::release(const std::string& key, SocketPtr socket) {
+    if (!socket) {
+        return;
+    }
+
+    // closing a connection may involve a TLS shutdown, it happens after the
+    // shard is unlocked when the displaced socket goes out of scope
+    SocketPtr displaced{};
+
+    Shard& shard = shardFor(key);
+    std::lock_guard<std::mutex> lock{shard.mutex};
+
+    IdleSockets& sockets = shard.idleSockets[key];
+    if (sockets.size() >= m_maxIdlePerHost) {
+        displaced = std::move(sockets.front().socket);
+        sockets.erase(sockets.begin());
+    }
+    sockets.push_back({std::move(socket), Clock::now()});
+}
+
+void ConnectionPool::evictIdle() {
+    const Clock::time_point now = Clock::now();
+
+    for (Shard& shard : *m_shards) {
+        evictIdle(shard, now);
+    }
+}
+
+// The idle sockets are taken out of the shard to be probed and the live ones
+// put back afterwards, the dead ones are closed with the shard unlocked.
+// Meanwhile acquire() does not find them and connects anew.
+void ConnectionPool::evictIdle(Shard& shard, Clock::time_point now) {
+    std::unordered_map<std::string, IdleSockets> candidates{};
+    {
+        std::lock_guard<std::mutex> lock{shard.mutex};
+        candidates.swap(shard.idleSockets);
+        shard.idleSockets.max_load_factor(0.75);
+        shard.lastEviction = now;
+    }
+
+    for (auto& p : candidates) {
+        IdleSockets& sockets = p.second;
+        sockets.erase(std::remove_if(sockets.begin(), sockets.end(), [this, now](const PooledSocket& pooledSocket) {
+            return isExpired(pooledSocket, now) || !pooledSocket.socket->isAlive();
+        }), sockets.end());
+    }
+
+    // sockets released in the meantime are the more recently used, the oldest
+    // ones go when there are too many, closed once the lock is released
+    std::vector<SocketPtr> displaced{};
+    std::lock_guard<std::mutex> lock{shard.mutex};
+    for (auto& p : candidates) {
+        if (p.second.empty()) {
+            continue;
+        }
+
+        IdleSockets& sockets = shard.idleSockets[p.first];
+        sockets.insert(sockets.begin(), std::make_move_iterator(p.second.begin()), std::make_move_iterator(p.second.end()));
+        p.second.clear();
+
+        while (sockets.size() > m_maxIdlePerHost) {
+            displaced.push_back(std::move(sockets.front().socket));
+            sockets.erase(sockets.begin());
+        }
+    }
+}
+
+void ConnectionPool::clear() {
+    for (Shard& shard : *m_shards) {
+        std::unordered_map<std::string, IdleSockets> sockets{};
+        std::lock_guard<std::mutex> lock{shard.mutex};
+        sockets.swap(shard.idleSockets);
+    }
+}
+
+size_t ConnectionPool::idleCount() const {
+    size_t count = 0;
+    for (const Shard& shard : *m_shards) {
+        std::lock_guard<std::mutex> lock{shard.mutex};
+        for (const auto& p : shard.idleSockets) {
+            count += p.second.size();
+        }
+    }
+    return count;
+}
+
+void ConnectionPool::setIdleTimeout(std::chrono::seconds timeout) {
+    m_idleTimeout = timeout;
+}
+
+std::chrono::seconds ConnectionPool::idleTimeout() const noexcept {
+    return m_idleTimeout;
+}
+
+void ConnectionPool::setMaxIdlePerHost(size_t count) {
+    m_maxIdlePerHost = std::max<size_t>(count, 1);
+}
+
+size_t ConnectionPool::maxIdlePerHost() const noexcept {
+    return m_maxIdlePerHost;
+}
+
+void ConnectionPool::startReaper(std::chrono::seconds interval) {
+    stopReaper();
+
+    m_reaper = std::make_unique<Reaper>();
+    m_reaper->pool = this;
+
+    Reaper& reaper = *m_reaper;
+    reaper.thread = std::thread{[&reaper, interval]() {
+        std::unique_lock<std::mutex> lock{reaper.mutex};
+        while (!reaper.wake.wait_for(lock, interval, [&reaper]() { return reaper.stopped; })) {
+            reaper.pool->evictIdle();
+        }
+    }};
+}
+
+void ConnectionPool::stopReaper() {
+    if (!m_reaper) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock{m_reaper->mutex};
+        m_reaper->stopped = true;
+    }
+    m_reaper->wake.notify_one();
+    m_reaper->thread.join();
+    m_reaper.reset();
+}
+
+bool ConnectionPool::reaperRunning() const noexcept {
+    return m_reaper != nullptr;
+}
+
+ConnectionPool::Shard& ConnectionPool::shardFor(const std::string& key) {
+    return (*m_shards)[std::hash<std::string>{}(key) % SHARD_COUNT];
+}
+
+bool ConnectionPool::isExpired(const PooledSocket& pooledSocket, Clock::time_point now) const {
+    return now - pooledSocket.lastUsed > m_idleTimeout;
+}
+
+void swap(ConnectionPool& first, ConnectionPool& second) {
+    if (&first == &second) {
+        return;
+    }
+
+    // both reaper mutexes are taken at once, two swaps of the same pools in
+    // opposite order must not deadlock
+    std::unique_lock<std::mutex> firstLock{}, secondLock{};
+    if (first.m_reaper) {
+        firstLock = std::unique_lock<std::mutex>{first.m_reaper->mutex, std::defer_lock};
+    }
+    if (second.m_reaper) {
+        secondLock = std::unique_lock<std::mutex>{second.m_reaper->mutex, std::defer_lock};
+    }
+    if (firstLock.mutex() && secondLock.mutex()) {
+        std::lock(firstLock, secondLock);
+    } else if (firstLock.mutex()) {
+        firstLock.lock();
+    } else if (secondLock.mutex()) {
+        secondLock.lock();
+    }
+
+    using std::swap;
+    swap(first.m_shards, second.m_shards);
+    swap(first.m_reaper, second.m_reaper);
+    swap(first.m_idleTimeout, second.m_idleTimeout);
+    swap(first.m_maxIdlePerHost, second.m_maxIdlePerHost);
+
+    // each reaper follows the pool it was moved into
+    if (first.m_reaper) {
+        first.m_reaper->pool = &first;
+    }
+    if (second.m_reaper) {
+        second.m_reaper->pool = &second;
+    }
+}
+
+}
@@ -0,0 +1,315 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <openssl/evp.h>
+
+#include "DiskCache.h"
+
+namespace Http {
+
+static const uint32_t INDEX_MAGIC = 0x48434458;
+static const uint32_t INDEX_VERSION = 2;
+static const uint32_t RECORD_MAGIC = 0x48435244;
+
+static const uint64_t EMPTY_SLOT = 0;
+static const uint64_t TOMBSTONE = 1;
+
+// Keys are urls and carry the access token, only their SHA-256 goes to disk.
+static std::string digest(const std::string& key) {
+    unsigned char md[EVP_MAX_MD_SIZE];
+    unsigned int length = 0;
+    if (!EVP_Digest(key.data(), key.length(), md, &length, EVP_sha256(), nullptr)) {
+        throw std::runtime_error("failed to hash cache key");
+    }
+    return std::string{reinterpret_cast<const char*>(md), length};
+}
+
+DiskCache::DiskCache(const std::string& directory, uint64_t capacity, uint64_t segmentSize, uint64_t slotCount) :
+    m_directory{directory},
+    m_maxSegments{std::max<uint64_t>(capacity / std::max<uint64_t>(segmentSize, 1), 2)},
+    m_segmentSize{std::max<uint64_t>(segmentSize, 1)},
+    m_slotCount{std::max<uint64_t>(slotCount, 16)} {
+
+    m_index = MappedFile{m_directory + "/index", sizeof(IndexHeader) + m_slotCount * sizeof(IndexSlot)};
+
+    const IndexHeader& indexHeader = header();
+    if (indexHeader.magic != INDEX_MAGIC || indexHeader.version != INDEX_VERSION || indexHeader.slotCount != m_slotCount) {
+        reset();
+    }
+
+    openWriter();
+}
+
+DiskCache::~DiskCache() {}
+
+HttpCache::EntryPtr DiskCache::lookup(const std::string& key) {
+    const std::string keyDigest = digest(key);
+
+    std::lock_guard<std::mutex> lock{m_mutex};
+
+    IndexSlot* slot = findSlot(hash(keyDigest));
+    if (!slot) {
+        return nullptr;
+    }
+
+    std::ifstream in{segmentPath(slot->segment), std::ios::binary};
+    in.seekg(static_cast<std::streamoff>(slot->offset));
+
+    RecordHeader record{};
+    in.read(reinterpret_cast<char*>(&record), sizeof(record));
+
+    // whatever does not look like the record the slot promised, e.g. the tail
+    // of a segment cut short by a crash, is dropped from the index
+    if (!in || record.magic != RECORD_MAGIC || sizeof(record) + record.keyLength + record.responseLength != slot->length) {
+        slot->hash = TOMBSTONE;
+        --header().liveCount;
+        return nullptr;
+    }
+
+    std::string storedKey(record.keyLength, '\0');
+    in.read(&storedKey[0], static_cast<std::streamsize>(storedKey.length()));
+    if (!in || storedKey != keyDigest) {
+        return nullptr;
+    }
+
+    std::string rawResponse(record.responseLength, '\0');
+    in.read(&rawResponse[0], static_cast<std::streamsize>(rawResponse.length()));
+    if (!in) {
+        return nullptr;
+    }
+
+    HttpResponse response{};
+    response = rawResponse;
+    return CacheEntry::create(response, static_cast<std::time_t>(record.responseTime));
+}
+
+void DiskCache::store(const std::string& key, EntryPtr entry) {
+    if (!entry) {
+        remove(key);
+        return;
+    }
+
+    const std::string keyDigest = digest(key);
+    const std::string rawResponse = entry->response.getString();
+
+    RecordHeader record{};
+    record.magic = RECORD_MAGIC;
+    record.keyLength = static_cast<uint32_t>(keyDigest.length());
+    record.responseLength = rawResponse.length();
+    record.responseTime = static_cast<int64_t>(entry->responseTime);
+
+    const uint64_t length = sizeof(record) + keyDigest.length() + rawResponse.length();
+
+    std::lock_guard<std::mutex> lock{m_mutex};
+
+    if (m_writerOffset > 0 && m_writerOffset + length > m_segmentSize) {
+        rotateSegment();
+    }
+
+    const uint64_t offset = m_writerOffset;
+    m_writer.write(reinterpret_cast<const char*>(&record), sizeof(record));
+    m_writer.write(keyDigest.data(), static_cast<std::streamsize>(keyDigest.length()));
+    m_writer.write(rawResponse.data(), static_cast<std::streamsize>(rawResponse.length()));
+    m_writer.flush();
+
+    // a full disk only means the response is not cached
+    if (!m_writer) {
+        m_writer.clear();
+        return;
+    }
+
+    m_writerOffset += length;
+    insertSlot({hash(keyDigest), header().lastSegment, offset, length});
+}
+
+void DiskCache::remove(const std::string& key) {
+    const std::string keyDigest = digest(key);
+
+    std::lock_guard<std::mutex> lock{m_mutex};
+
+    IndexSlot* slot = findSlot(hash(keyDigest));
+    if (slot) {
+        slot->hash = TOMBSTONE;
+        --header().liveCount;
+    }
+}
+
+void DiskCache::clear() {
+    std::lock_guard<std::mutex> lock{m_mutex};
+
+    m_writer.close();
+    reset();
+    openWriter();
+}
+
+uint64_t DiskCache::entryCount() const {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    return reinterpret_cast<const IndexHeader*>(m_index.data())->liveCount;
+}
+
+uint64_t DiskCache::hash(const std::string& key) noexcept {
+    uint64_t result = 14695981039346656037ull;
+    for (char c : key) {
+        result ^= static_cast<unsigned char>(c);
+        result *= 1099511628211ull;
+    }
+
+    // the two lowest values mark empty and removed slots
+    return result > TOMBSTONE ? result : result + 2;
+}
+
+DiskCache::IndexHeader& DiskCache::header() noexcept {
+    return *reinterpret_cast<IndexHeader*>(m_index.data());
+}
+
+DiskCache::IndexSlot* DiskCache::slots() noexcept {
+    return reinterpret_cast<IndexSlot*>(m_index.data() + sizeof(IndexHeader));
+}
+
+DiskCache::IndexSlot* DiskCache::findSlot(uint64_t hash) noexcept {
+    IndexSlot* table = slots();
+
+    uint64_t i = hash % m_slotCount;
+    for (uint64_t probes = 0; probes < m_slotCount && table[i].hash != EMPTY_SLOT; ++probes) {
+        if (table[i].hash == hash) {
+            return &table[i];
+        }
+        i = (i + 1) % m_slotCount;
+    }
+
+    return nullptr;
+}
+
+void DiskCache::insertSlot(const IndexSlot& slot) {
+    IndexSlot* existing = findSlot(slot.hash);
+    if (existing) {
+        *existing = slot;
+        return;
+    }
+
+    IndexHeader& indexHeader = header();
+    const uint64_t limit = m_slotCount / 4 * 3;
+
+    if (indexHeader.usedCount + 1 > limit) {
+        rebuildIndex();
+    }
+    while (indexHeader.liveCount + 1 > limit && indexHeader.firstSegment < slot.segment) {
+        evictSegment(indexHeader.firstSegment);
+    }
+    if (indexHeader.liveCount + 1 > limit) {
+        return;
+    }
+
+    IndexSlot* table = slots();
+    uint64_t i = slot.hash % m_slotCount;
+    while (table[i].hash > TOMBSTONE) {
+        i = (i + 1) % m_slotCount;
+    }
+
+    if (table[i].hash == EMPTY_SLOT) {
+        ++indexHeader.usedCount;
+    }
+    table[i] = slot;
+    ++indexHeader.liveCount;
+}
+
+void DiskCache::rebuildIndex() {
+    IndexSlot* table = slots();
+
+    std::vector<IndexSlot> live{};
+    live.reserve(header().liveCount);
+    std::copy_if(table, table + m_slotCount, std::back_inserter(live), [](const IndexSlot& slot) {
+        return slot.hash > TOMBSTONE;
+    });
+
+    std::memset(table, 0, m_slotCount * sizeof(IndexSlot));
+    for (const IndexSlot& slot : live) {
+        uint64_t i = slot.hash % m_slotCount;
+        while (table[i].hash != EMPTY_SLOT) {
+            i = (i + 1) % m_slotCount;
+        }
+        table[i] = slot;
+    }
+
+    header().usedCount = header().liveCount = live.size();
+}
+
+std::string DiskCache::segmentPath(uint64_t segment) const {
+    return m_directory + "/segment-" + std::to_string(segment);
+}
+
+void DiskCache::openWriter() {
+    const std::string path = segmentPath(header().lastSegment);
+
+#ifndef _WIN32
+    // responses are private to the token that fetched them, the segments are
+    // created for the owner only, like the index
+    const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT, 0600);
+    if (fd != -1) {
+        ::close(fd);
+    }
+#endif
+
+    m_writer.close();
+    m_writer.open(path, std::ios::binary | std::ios::app);
+    if (!m_writer) {
+        throw std::runtime_error("failed to open cache segment " + path);
+    }
+
+    std::ifstream in{path, std::ios::binary | std::ios::ate};
+    m_writerOffset = static_cast<uint64_t>(std::max<std::streamoff>(in.tellg(), 0));
+}
+
+void DiskCache::rotateSegment() {
+    IndexHeader& indexHeader = header();
+
+    ++indexHeader.lastSegment;
+    openWriter();
+
+    while (indexHeader.lastSegment - indexHeader.firstSegment + 1 > m_maxSegments) {
+        evictSegment(indexHeader.firstSegment);
+    }
+}
+
+void DiskCache::evictSegment(uint64_t segment) {
+    IndexHeader& indexHeader = header();
+    IndexSlot* table = slots();
+
+    for (uint64_t i = 0; i < m_slotCount; ++i) {
+        if (table[i].hash > TOMBSTONE && table[i].segment == segment) {
+            table[i].hash = TOMBSTONE;
+            --indexHeader.liveCount;
+        }
+    }
+
+    std::remove(segmentPath(segment).c_str());
+    if (segment == indexHeader.firstSegment) {
+        ++indexHeader.firstSegment;
+    }
+}
+
+void DiskCache::reset() {
+    IndexHeader& indexHeader = header();
+    if (indexHeader.magic == INDEX_MAGIC) {
+        for (uint64_t segment = indexHeader.firstSegment; segment <= indexHeader.lastSegment; ++segment) {
+            std::remove(segmentPath(segment).c_str());
+        }
+    }
+
+    std::memset(m_index.data(), 0, m_index.size());
+
+    indexHeader.magic = INDEX_MAGIC;
+    indexHeader.version = INDEX_VERSION;
+    indexHeader.slotCount = m_slotCount;
+}
+
+}
@@ -0,0 +1,53 @@
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "FanOut.h"
+
+namespace Http {
+
+void fanOut(size_t count, size_t concurrency, const std::function<void(size_t)>& task) {
+    std::atomic<size_t> next{0};
+    std::mutex errorMutex{};
+    std::exception_ptr error{};
+
+    auto worker = [&]() {
+        for (size_t i = next++; i < count; i = next++) {
+            try {
+                task(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock{errorMutex};
+                if (!error) {
+                    error = std::current_exception();
+                }
+                next = count;
+            }
+        }
+    };
+
+    const size_t workerCount = std::min(std::max<size_t>(concurrency, 1), count);
+
+    std::vector<std::thread> workers{};
+    try {
+        for (size_t i = 1; i < workerCount; ++i) {
+            workers.emplace_back(worker);
+        }
+    } catch (const std::system_error&) {
+        // fewer workers than asked for still get through every index
+    }
+
+    worker();
+    for (std::thread& thread : workers) {
+        thread.join();
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+}
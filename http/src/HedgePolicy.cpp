@@ -0,0 +1,99 @@
+#include <algorithm>
+
+#include "HedgePolicy.h"
+
+namespace Http {
+
+LatencyWindow::LatencyWindow(size_t capacity) : m_capacity{std::max<size_t>(capacity, 1)} {
+    m_samples.reserve(m_capacity);
+}
+
+void LatencyWindow::add(Duration latency) {
+    if (m_samples.size() < m_capacity) {
+        m_samples.push_back(latency);
+    } else {
+        m_samples[m_next] = latency;
+    }
+    m_next = (m_next + 1) % m_capacity;
+}
+
+LatencyWindow::Duration LatencyWindow::percentile(double percentile) const {
+    if (m_samples.empty()) {
+        return Duration{0};
+    }
+
+    std::vector<Duration> sorted{m_samples};
+    size_t rank = static_cast<size_t>(std::clamp(percentile, 0.0, 1.0) * static_cast<double>(sorted.size() - 1));
+    std::nth_element(sorted.begin(), sorted.begin() + static_cast<std::ptrdiff_t>(rank), sorted.end());
+
+    return sorted[rank];
+}
+
+size_t LatencyWindow::size() const noexcept {
+    return m_samples.size();
+}
+
+HedgePolicy::HedgePolicy() {}
+
+HedgePolicy::HedgePolicy(double percentile, Duration minDelay, Duration maxDelay) : m_enabled{true},
+                                                                                    m_percentile{percentile},
+                                                                                    m_minDelay{minDelay},
+                                                                                    m_maxDelay{maxDelay} {}
+
+void HedgePolicy::setEnabled(bool enabled) {
+    m_enabled = enabled;
+}
+
+bool HedgePolicy::enabled() const noexcept {
+    return m_enabled;
+}
+
+void HedgePolicy::setPercentile(double percentile) {
+    m_percentile = percentile;
+}
+
+double HedgePolicy::percentile() const noexcept {
+    return m_percentile;
+}
+
+void HedgePolicy::setMinDelay(Duration delay) {
+    m_minDelay = delay;
+}
+
+HedgePolicy::Duration HedgePolicy::minDelay() const noexcept {
+    return m_minDelay;
+}
+
+void HedgePolicy::setMaxDelay(Duration delay) {
+    m_maxDelay = delay;
+}
+
+HedgePolicy::Duration HedgePolicy::maxDelay() const noexcept {
+    return m_maxDelay;
+}
+
+void HedgePolicy::setInitialDelay(Duration delay) {
+    m_initialDelay = delay;
+}
+
+HedgePolicy::Duration HedgePolicy::initialDelay() const noexcept {
+    return m_initialDelay;
+}
+
+void HedgePolicy::setMinSamples(size_t count) {
+    m_minSamples = count;
+}
+
+size_t HedgePolicy::minSamples() const noexcept {
+    return m_minSamples;
+}
+
+HedgePolicy::Duration HedgePolicy::delay(const LatencyWindow& window) const {
+    if (window.size() < m_minSamples) {
+        return m_initialDelay;
+    }
+
+    return std::clamp(window.percentile(m_percentile), m_minDelay, m_maxDelay);
+}
+
+}
@@ -1,6 +1,8 @@
 #include <cstring>
 #include <unordered_map>
 #include <algorithm>
+#include <iomanip>
+#include <sstream>
 #include "Http.h"
 
 namespace Http {
@@ -70,6 +72,20 @@ namespace Http {
                 return "transfer-encoding";
             case Header::LOCATION:
                 return "location";
+            case Header::RETRY_AFTER:
+                return "retry-after";
+            case Header::ETAG:
+                return "etag";
+            case Header::IF_NONE_MATCH:
+                return "if-none-match";
+            case Header::LAST_MODIFIED:
+                return "last-modified";
+            case Header::IF_MODIFIED_SINCE:
+                return "if-modified-since";
+            case Header::DATE:
+                return "date";
+            case Header::AGE:
+                return "age";
             default:
                 return "unknown";
         }
@@ -89,8 +105,18 @@ namespace Http {
                 return "INTERNAL_SERVER_ERROR";
             case Status::NOT_FOUND:
                 return "NOT FOUND";
+            case Status::TOO_MANY_REQUESTS:
+                return "TOO MANY REQUESTS";
+            case Status::BAD_GATEWAY:
+                return "BAD GATEWAY";
+            case Status::SERVICE_UNAVAILABLE:
+                return "SERVICE UNAVAILABLE";
+            case Status::GATEWAY_TIMEOUT:
+                return "GATEWAY TIMEOUT";
             case Status::MOVED:
                 return "MOVED";
+            case Status::NOT_MODIFIED:
+                return "NOT MODIFIED";
             default:
                 return "UNKNOWN";
         }
@@ -115,9 +141,14 @@ namespace Http {
             case Status::FORBIDDEN:
             case Status::INTERNAL_SERVER_ERROR:
             case Status::MOVED:
+            case Status::NOT_MODIFIED:
             case Status::NOT_FOUND:
             case Status::OK:
             case Status::UNAUTHORIZED:
+            case Status::TOO_MANY_REQUESTS:
+            case Status::BAD_GATEWAY:
+            case Status::SERVICE_UNAVAILABLE:
+            case Status::GATEWAY_TIMEOUT:
                 return status;
             default:
                 return Status::UNKNOWN;
@@ -146,6 +177,34 @@ namespace Http {
         return fromStr(str.c_str());
     }
 
+    bool isIdempotent(Method method) noexcept {
+        switch (method) {
+            case Method::GET:
+            case Method::HEAD:
+            case Method::DELETE:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    std::time_t parseHttpDate(const std::string &date) {
+        std::tm tm{};
+        std::istringstream stream{date};
+        stream.imbue(std::locale::classic());
+        stream >> std::get_time(&tm, "%a, %d %b %Y %H:%M:%S");
+
+        if (stream.fail()) {
+            return -1;
+        }
+
+#ifdef _WIN32
+        return _mkgmtime(&tm);
+#else
+        return timegm(&tm);
+#endif
+    }
+
     std::string trim(const std::string &str) {
         size_t space_start_pos = str.find_first_not_of(' ');
         space_start_pos = space_start_pos == std::string::npos ? 0 : space_start_pos;
@@ -180,7 +239,7 @@ namespace Http {
 
             result.push_back(trim(std::string {begin, ptr}));
             if (once && ++ptr < end) {
-                result.push_back(trim(std::string {ptr, end - 1}));
+                result.push_back(trim(std::string {ptr, end}));
                 break;
             }
         } while (end > ++ptr);
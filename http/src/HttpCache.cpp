@@ -0,0 +1,106 @@
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+
+#include "HttpCache.h"
+
+namespace Http {
+
+// RFC 7234 1.2.1 caps delta-seconds at 2^31, one less keeps it in a 32 bit long
+static std::time_t parseSeconds(const std::string& value) {
+    const long long limit = 2147483647LL;
+
+    if (value.empty() || !std::all_of(value.begin(), value.end(), [](unsigned char c) { return std::isdigit(c); })) {
+        return -1;
+    }
+
+    errno = 0;
+    const long long seconds = std::strtoll(value.c_str(), nullptr, 10);
+    if (errno == ERANGE || seconds > limit) {
+        return static_cast<std::time_t>(limit);
+    }
+    return static_cast<std::time_t>(seconds);
+}
+
+CacheControl CacheControl::parse(const std::string& value) {
+    CacheControl cacheControl{};
+    if (value.empty()) {
+        return cacheControl;
+    }
+
+    for (const std::string& directive : split(changeCase(value), ',')) {
+        const size_t separator = directive.find('=');
+        const std::string name = directive.substr(0, separator);
+        const std::string argument = separator == std::string::npos ? "" : directive.substr(separator + 1);
+
+        if (name == "no-store") {
+            cacheControl.noStore = true;
+        } else if (name == "no-cache") {
+            cacheControl.noCache = true;
+        } else if (name == "max-age") {
+            cacheControl.maxAge = static_cast<long>(parseSeconds(argument));
+        }
+    }
+
+    return cacheControl;
+}
+
+std::shared_ptr<const CacheEntry> CacheEntry::create(const HttpResponse& response, std::time_t responseTime) {
+    if (response.code() != Status::OK || response.isBodyMapped()) {
+        return nullptr;
+    }
+
+    const CacheControl cacheControl = CacheControl::parse(response[Header::CACHE_CONTROL]);
+    if (cacheControl.noStore) {
+        return nullptr;
+    }
+
+    auto entry = std::make_shared<CacheEntry>();
+    entry->response = response;
+    entry->responseTime = responseTime;
+    entry->initialAge = std::max<std::time_t>(parseSeconds(response[Header::AGE]), 0);
+    entry->alwaysRevalidate = cacheControl.noCache;
+
+    std::time_t date = parseHttpDate(response[Header::DATE]);
+    if (date == -1) {
+        date = responseTime;
+    }
+
+    // RFC 7234 4.2.1, max-age wins over Expires, otherwise fall back to the
+    // usual heuristic of a tenth of the time since the last modification
+    if (cacheControl.maxAge >= 0) {
+        entry->freshnessLifetime = cacheControl.maxAge;
+    } else if (response.isContainsHeader(Header::EXPIRES)) {
+        std::time_t expires = parseHttpDate(response[Header::EXPIRES]);
+        entry->freshnessLifetime = expires == -1 ? 0 : std::max<std::time_t>(expires - date, 0);
+    } else {
+        std::time_t lastModified = parseHttpDate(response[Header::LAST_MODIFIED]);
+        if (lastModified != -1 && lastModified < date) {
+            entry->freshnessLifetime = (date - lastModified) / 10;
+        }
+    }
+
+    if (entry->freshnessLifetime == 0 && !entry->hasValidator()) {
+        return nullptr;
+    }
+
+    entry->size = response.getString().length();
+    return entry;
+}
+
+bool CacheEntry::isFresh(std::time_t now) const noexcept {
+    return !alwaysRevalidate && freshnessLifetime > age(now);
+}
+
+bool CacheEntry::hasValidator() const noexcept {
+    return response.isContainsHeader(Header::ETAG) || response.isContainsHeader(Header::LAST_MODIFIED);
+}
+
+std::time_t CacheEntry::age(std::time_t now) const noexcept {
+    return initialAge + std::max<std::time_t>(now - responseTime, 0);
+}
+
+HttpCache::~HttpCache() {}
+
+}
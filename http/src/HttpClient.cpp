@@ -1,24 +1,87 @@
 //
 // Created by inside on 4/23/16.
 //
-#include <limits>
+#include <algorithm>
 #include <cstring>
+#include <thread>
 
 #include "SSLSocket.h"
 #include "HttpClient.h"
+#include "FanOut.h"
 #include "FormData.h"
 #include "HttpRequest.h"
 #include "HttpResponse.h"
+#include "MappedFile.h"
 
+#include "exceptions/HttpConnClosed.h"
+#include "exceptions/HttpConnRefused.h"
 #include "exceptions/HttpFailedToRecieve.h"
 #include "exceptions/HttpFailedToSend.h"
 #include "exceptions/HttpTooBigResponse.h"
 
 namespace Http {
 
-HttpClient::HttpClient(){
-    m_hostToSocketMap.max_load_factor(0.75);
-}
+static const unsigned int RECEIVE_TIMEOUT = 20;
+
+// Body of a response still arriving on the socket, the part already read
+// together with the head is served first.
+class SocketBodySource : public BodySource {
+public:
+    SocketBodySource(const ConnectionPool::SocketPtr& socket, unsigned int timeout, std::string buffered, size_t contentLen) :
+        m_socket{socket}, m_timeout{timeout}, m_buffered{std::move(buffered)} {
+        m_buffered.resize(std::min(m_buffered.size(), contentLen));
+        m_remaining = contentLen - m_buffered.size();
+    }
+
+    size_t read(char* buffer, size_t size) override {
+        if (m_offset < m_buffered.size()) {
+            const size_t count = std::min(size, m_buffered.size() - m_offset);
+            std::memcpy(buffer, m_buffered.data() + m_offset, count);
+            m_offset += count;
+            return count;
+        }
+
+        while (m_remaining > 0 && size > 0) {
+            if (!m_socket->waitForRead(m_timeout)) {
+                throw HttpFailedToRecieve{"timed out waiting for response body"};
+            }
+
+            const long count = m_socket->read(buffer, std::min(size, m_remaining));
+            if (count > 0) {
+                m_remaining -= static_cast<size_t>(count);
+                m_received += static_cast<size_t>(count);
+                return static_cast<size_t>(count);
+            }
+            if (count == 0) {
+                throw HttpConnClosed{"connection closed by peer"};
+            }
+
+            switch (m_socket->lastError()) {
+            case Socket::Error::WOULDBLOCK:
+            case Socket::Error::INTERRUPTED:
+                continue;
+            default:
+                throw HttpFailedToRecieve{std::string{"Failed to recieve data : "} + m_socket->lastErrorString()};
+            }
+        }
+
+        return 0;
+    }
+
+    // Bytes taken from the socket, the ones that came with the head not included.
+    size_t received() const noexcept {
+        return m_received;
+    }
+private:
+    const ConnectionPool::SocketPtr& m_socket;
+    unsigned int m_timeout;
+    std::string m_buffered;
+    size_t m_offset{0};
+    size_t m_remaining{0};
+    size_t m_received{0};
+};
+
+HttpClient::HttpClient(){}
 
 HttpClient::HttpClient(HttpClient&& httpClient) : HttpClient{}{
     swap(*this, httpClient);
@@ -27,7 +90,17 @@ HttpClient::HttpClient(HttpClient&& httpClient) : HttpClient{}{
 HttpClient::~HttpClient() {}
 
 HttpClient& HttpClient::operator=(HttpClient&& client){
-    m_hostToSocketMap = std::move(client.m_hostToSocketMap);
+    m_connectionPool = std::move(client.m_connectionPool);
+    m_maxBodyInMemory = client.m_maxBodyInMemory;
+    m_maxResponseSize = client.m_maxResponseSize;
+    m_retryPolicy = client.m_retryPolicy;
+    m_hedgePolicy = client.m_hedgePolicy;
+    m_firstByteLatency = std::move(client.m_firstByteLatency);
+    m_observers = std::move(client.m_observers);
+    m_metrics = std::move(client.m_metrics);
+    m_cache = std::move(client.m_cache);
+    m_limiter = std::move(client.m_limiter);
+    m_throttle = std::move(client.m_throttle);
     return *this;
 }
 
@@ -39,6 +112,55 @@ HttpResponse HttpClient::get(const HttpUrl& url){
     return sendRequest(httpRequest);
 }
 
+std::vector<HttpResponse> HttpClient::sendBatch(const std::vector<HttpRequest>& httpRequests, size_t concurrency){
+    std::vector<HttpResponse> responses(httpRequests.size());
+
+    fanOut(httpRequests.size(), concurrency, [&](size_t i) {
+        responses[i] = sendRequest(httpRequests[i]);
+    });
+
+    return responses;
+}
+
+std::vector<HttpResponse> HttpClient::getBatch(const std::vector<HttpUrl>& urls, size_t concurrency){
+    std::vector<HttpRequest> httpRequests{};
+    httpRequests.reserve(urls.size());
+
+    for (const HttpUrl& url : urls) {
+        HttpRequest httpRequest = getDefaultRequest();
+        httpRequest.setMethod(Method::GET);
+        httpRequest.setUrl(url);
+        httpRequests.push_back(std::move(httpRequest));
+    }
+
+    return sendBatch(httpRequests, concurrency);
+}
+
+HttpResponse HttpClient::getStreamed(const HttpUrl& url, const BodyReader& reader){
+    HttpRequest httpRequest = getDefaultRequest();
+    httpRequest.setMethod(Method::GET);
+    httpRequest.setUrl(url);
+
+    if (!m_cache) {
+        return sendWithRetries(httpRequest, false, &reader);
+    }
+
+    HttpResponse response = sendRequest(httpRequest);
+    if (response.code() >= 200 && response.code() < 300) {
+        StringBodySource body{response.bodyView()};
+        reader(response, body);
+    }
+    return response;
+}
+
+HttpResponse HttpClient::hedgedGet(const HttpUrl& url){
+    HttpRequest httpRequest = getDefaultRequest();
+    httpRequest.setMethod(Method::GET);
+    httpRequest.setUrl(url);
+
+    return sendRequest(httpRequest, m_hedgePolicy.enabled());
+}
+
 HttpResponse HttpClient::post(const HttpUrl& url, const std::string& data, const std::string& content_type) {
     HttpRequest httpRequest = getDefaultRequest();
     httpRequest.setMethod(Method::POST);
@@ -83,24 +205,292 @@ HttpRequest HttpClient::getDefaultRequest() const {
 }
 
 HttpResponse HttpClient::sendRequest(const HttpRequest& httpRequest){
+    return sendRequest(httpRequest, false);
+}
+
+HttpResponse HttpClient::sendRequest(const HttpRequest& httpRequest, bool hedged){
+    if (!m_cache) {
+        return sendWithRetries(httpRequest, hedged);
+    }
+
+    const Method method = httpRequest.method();
+    if (method == Method::GET) {
+        return sendCached(httpRequest, hedged);
+    }
+
+    HttpResponse response = sendWithRetries(httpRequest, hedged);
+
+    // RFC 7234 4.4, a successful unsafe request invalidates the stored response
+    if (method != Method::HEAD && response.code() >= 200 && response.code() < 400) {
+        m_cache->remove(httpRequest.getUrl().url());
+    }
+    return response;
+}
+
+HttpResponse HttpClient::sendCached(const HttpRequest& httpRequest, bool hedged){
+    const std::string key = httpRequest.getUrl().url();
+    const bool noCache = CacheControl::parse(httpRequest[Header::CACHE_CONTROL]).noCache;
+
+    std::time_t now = std::time(nullptr);
+    HttpCache::EntryPtr entry = m_cache->lookup(key);
+
+    if (entry && !noCache && entry->isFresh(now)) {
+        HttpResponse response = entry->response;
+        response[Header::AGE] = std::to_string(entry->age(now));
+
+        response.m_timings = RequestTimings{};
+        response.m_timings.start = response.m_timings.lastByte = RequestTimings::Clock::now();
+        response.m_timings.cached = true;
+
+        notifyObservers(httpRequest, response);
+        return response;
+    }
+
+    if (!entry || !entry->hasValidator()) {
+        HttpResponse response = sendWithRetries(httpRequest, hedged);
+        m_cache->store(key, CacheEntry::create(response, std::time(nullptr)));
+        return response;
+    }
+
+    HttpRequest conditional{httpRequest};
+    if (entry->response.isContainsHeader(Header::ETAG)) {
+        conditional[Header::IF_NONE_MATCH] = entry->response[Header::ETAG];
+    }
+    if (entry->response.isContainsHeader(Header::LAST_MODIFIED)) {
+        conditional[Header::IF_MODIFIED_SINCE] = entry->response[Header::LAST_MODIFIED];
+    }
+
+    HttpResponse response = sendWithRetries(conditional, hedged);
+    now = std::time(nullptr);
+
+    if (response.code() != Status::NOT_MODIFIED) {
+        m_cache->store(key, CacheEntry::create(response, now));
+        return response;
+    }
+
+    // the stored body is still valid, only the metadata of the 304 is taken over
+    HttpResponse revalidated = entry->response;
+    for (Header header : {Header::CACHE_CONTROL, Header::EXPIRES, Header::DATE, Header::ETAG, Header::LAST_MODIFIED, Header::AGE}) {
+        if (response.isContainsHeader(header)) {
+            revalidated[header] = response[header];
+        }
+    }
+    revalidated.m_timings = response.m_timings;
+
+    m_cache->store(key, CacheEntry::create(revalidated, now));
+    return revalidated;
+}
+
+HttpResponse HttpClient::sendWithRetries(const HttpRequest& httpRequest, bool hedged, const BodyReader* reader){
+    RetryPolicy::Duration delay{0};
+
+    // once part of a body went to the reader the request cannot be repeated
+    bool streamed = false;
+    BodyReader streamingReader{};
+    if (reader) {
+        streamingReader = [reader, &streamed](const HttpResponse& response, BodySource& body) {
+            streamed = true;
+            (*reader)(response, body);
+        };
+    }
+
+    for (unsigned int attempt = 1;; ++attempt) {
+        if (m_throttle) {
+            m_throttle->wait(httpRequest);
+        }
+        if (m_limiter) {
+            m_limiter->acquire();
+        }
+
+        HttpResponse response{};
+        RequestTimings timings{};
+        timings.attempt = attempt;
+        timings.start = RequestTimings::Clock::now();
+
+        bool networkError = false;
+        bool retryable = true;
+
+        try{
+            response = execute(httpRequest, hedged, timings, reader ? &streamingReader : nullptr);
+        }catch(const HttpTooBigResponse& err){
+            std::string errMsg = "Internal client error : ";
+            response.setStatus(errMsg + err.what(), -1);
+            retryable = false;
+        }catch(const std::exception& err){
+            std::string errMsg = "Internal client error : ";
+            response.setStatus(errMsg + err.what(), -1);
+            networkError = true;
+        }catch(...){
+            response.setStatus("Unknown client error", -1);
+            networkError = true;
+        }
+
+        if (m_limiter) {
+            m_limiter->release(response.code(), timings.timeToFirstByte());
+        }
+
+        response.m_timings = timings;
+        notifyObservers(httpRequest, response);
+
+        if (streamed || !retryable || !m_retryPolicy.shouldRetry(httpRequest, response, networkError, attempt)) {
+            return response;
+        }
+
+        delay = m_retryPolicy.nextDelay(response, delay);
+        std::this_thread::sleep_for(delay);
+    }
+}
+
+// Connection phases are only attributed to the attempt that opened the socket,
+// a pooled socket connected before the attempt started reports none.
+static void recordConnection(RequestTimings& timings, const Socket::TCPSocket& socket) {
+    const Socket::ConnectTimings& connectTimings = socket.connectTimings();
+
+    timings.reusedConnection = connectTimings.start < timings.start;
+    if (timings.reusedConnection) {
+        timings.dnsStart = timings.dnsEnd = timings.connectEnd = timings.tlsEnd = {};
+        return;
+    }
+
+    timings.dnsStart = connectTimings.start;
+    timings.dnsEnd = connectTimings.resolved;
+    timings.connectEnd = connectTimings.connected;
+    timings.tlsEnd = connectTimings.secured;
+}
+
+HttpResponse HttpClient::execute(const HttpRequest& httpRequest, bool hedged, RequestTimings& timings, const BodyReader* reader) {
+    const HttpUrl& url = httpRequest.getUrl();
+    const std::string key = poolKey(url);
+
+    SocketPtr socket = m_connectionPool.acquire(key);
+    const bool reused = socket != nullptr;
+    if (!reused) {
+        socket = connect(url);
+    }
+    recordConnection(timings, *socket);
+
     HttpResponse response{};
-    try{
-        send(httpRequest);
-        response = receive(httpRequest.getUrl(), 20);
+    try {
+        response = exchange(socket, key, httpRequest, hedged, timings, reader);
+    } catch (const HttpBaseException&) {
+        // the peer may close a pooled connection between the liveness probe and
+        // the request, idempotent requests are safe to repeat on a fresh one as
+        // long as nothing of the response arrived yet
+        if (!reused || !isIdempotent(httpRequest.method()) || timings.firstByte != RequestTimings::Clock::time_point{}) {
+            throw;
+        }
+
+        socket = connect(url);
+        recordConnection(timings, *socket);
+        response = exchange(socket, key, httpRequest, false, timings, reader);
+    }
+
+    if (response.code() != Status::UNKNOWN && changeCase(response[Header::CONNECTION]) != "close") {
+        m_connectionPool.release(key, std::move(socket));
+    }
+
+    return response;
+}
 
-        if (response[Header::CONNECTION] == "close") {
-            disconnect(httpRequest.getUrl());
+HttpResponse HttpClient::exchange(SocketPtr& socket, const std::string& key, const HttpRequest& httpRequest, bool hedged, RequestTimings& timings, const BodyReader* reader) {
+    timings.bytesSent = send(socket, httpRequest);
+    timings.requestSent = RequestTimings::Clock::now();
+
+    if (!m_hedgePolicy.enabled()) {
+        return receive(socket, RECEIVE_TIMEOUT, timings, reader);
+    }
+
+    const std::chrono::milliseconds timeout{RECEIVE_TIMEOUT * 1000};
+
+    int ready = -1;
+    bool hedgeSlot = false;
+    if (hedged) {
+        ready = Socket::TCPSocket::waitForAnyRead({socket.get()}, hedgeDelay(key));
+        if (ready == -1) {
+            SocketPtr hedge = sendHedge(key, httpRequest);
+            hedgeSlot = hedge && m_limiter;
+            if (hedge) {
+                const RequestTimings::Clock::time_point hedgeSent = RequestTimings::Clock::now();
+                ready = Socket::TCPSocket::waitForAnyRead({socket.get(), hedge.get()}, timeout);
+
+                // the losing connection still has a response in flight and is
+                // dropped instead of going back to the pool
+                if (ready == 1) {
+                    socket = std::move(hedge);
+                    recordConnection(timings, *socket);
+                    timings.requestSent = hedgeSent;
+                    timings.hedged = true;
+                }
+            }
         }
-    }catch(const std::exception& err){
-        std::string errMsg = "Internal client error : ";
-        response.setStatus(errMsg + err.what(), -1);
-    }catch(...){
-        response.setStatus("Unknown client error", -1);
     }
 
+    if (ready == -1) {
+        ready = Socket::TCPSocket::waitForAnyRead({socket.get()}, timeout);
+    }
+
+    if (ready != -1) {
+        recordFirstByte(key, std::chrono::duration_cast<LatencyWindow::Duration>(RequestTimings::Clock::now() - timings.requestSent));
+    }
+
+    if (!hedgeSlot) {
+        return receive(socket, RECEIVE_TIMEOUT, timings, reader);
+    }
+
+    // the hedge's slot is given back without a latency sample, the attempt
+    // releasing the other one already reports it
+    HttpResponse response{};
+    try {
+        response = receive(socket, RECEIVE_TIMEOUT, timings, reader);
+    } catch (...) {
+        m_limiter->release(-1, ConcurrencyLimiter::Duration{0});
+        throw;
+    }
+    m_limiter->release(response.code(), ConcurrencyLimiter::Duration{0});
     return response;
 }
 
+// Hedges count against the throttle and the limiter like any attempt, but
+// are skipped rather than waited for when there is no room for them.
+HttpClient::SocketPtr HttpClient::sendHedge(const std::string& key, const HttpRequest& httpRequest) {
+    // the limiter slot can be handed back unused, a throttle token can not
+    if (m_limiter && !m_limiter->tryAcquire()) {
+        return nullptr;
+    }
+    if (m_throttle && !m_throttle->tryPass(httpRequest)) {
+        if (m_limiter) {
+            m_limiter->cancel();
+        }
+        return nullptr;
+    }
+
+    try {
+        SocketPtr socket = m_connectionPool.acquire(key);
+        if (!socket) {
+            socket = connect(httpRequest.getUrl());
+        }
+
+        send(socket, httpRequest);
+        return socket;
+    } catch (const std::exception&) {
+        // a failed hedge must not fail the request still running on the primary
+        if (m_limiter) {
+            m_limiter->release(-1, ConcurrencyLimiter::Duration{0});
+        }
+        return nullptr;
+    }
+}
+
+HedgePolicy::Duration HttpClient::hedgeDelay(const std::string& key) {
+    std::lock_guard<std::mutex> lock{m_latencyMutex};
+    return m_hedgePolicy.delay(m_firstByteLatency[key]);
+}
+
+void HttpClient::recordFirstByte(const std::string& key, LatencyWindow::Duration latency) {
+    std::lock_guard<std::mutex> lock{m_latencyMutex};
+    m_firstByteLatency[key].add(latency);
+}
+
 HttpResponse HttpClient::operator<<(const HttpRequest &httpRequest) {
     return sendRequest(httpRequest);
 }
@@ -109,16 +499,113 @@ HttpResponse HttpClient::operator<<(const HttpUrl& url) {
     return get(url);
 }
 
-void HttpClient::send(const HttpRequest& httpRequest) {
+void HttpClient::setMaxBodyInMemory(size_t bytes) {
+    m_maxBodyInMemory = bytes;
+}
+
+size_t HttpClient::maxBodyInMemory() const noexcept {
+    return m_maxBodyInMemory;
+}
+
+void HttpClient::setMaxResponseSize(size_t bytes) {
+    m_maxResponseSize = bytes;
+}
+
+size_t HttpClient::maxResponseSize() const noexcept {
+    return m_maxResponseSize;
+}
+
+void HttpClient::setIdleTimeout(std::chrono::seconds timeout) {
+    m_connectionPool.setIdleTimeout(timeout);
+}
+
+std::chrono::seconds HttpClient::idleTimeout() const noexcept {
+    return m_connectionPool.idleTimeout();
+}
+
+void HttpClient::evictIdleConnections() {
+    m_connectionPool.evictIdle();
+}
+
+void HttpClient::setEvictionInterval(std::chrono::seconds interval) {
+    if (interval.count() > 0) {
+        m_connectionPool.startReaper(interval);
+    } else {
+        m_connectionPool.stopReaper();
+    }
+}
+
+void HttpClient::setRetryPolicy(const RetryPolicy& retryPolicy) {
+    m_retryPolicy = retryPolicy;
+}
+
+const RetryPolicy& HttpClient::retryPolicy() const noexcept {
+    return m_retryPolicy;
+}
+
+void HttpClient::setHedgePolicy(const HedgePolicy& hedgePolicy) {
+    m_hedgePolicy = hedgePolicy;
+}
+
+const HedgePolicy& HttpClient::hedgePolicy() const noexcept {
+    return m_hedgePolicy;
+}
+
+void HttpClient::addObserver(std::shared_ptr<RequestObserver> observer) {
+    if (observer) {
+        m_observers.push_back(std::move(observer));
+    }
+}
+
+void HttpClient::removeObserver(const std::shared_ptr<RequestObserver>& observer) {
+    m_observers.erase(std::remove(m_observers.begin(), m_observers.end(), observer), m_observers.end());
+}
+
+void HttpClient::setMetrics(std::shared_ptr<MetricsRegistry> metrics) {
+    removeObserver(m_metrics);
+    m_metrics = std::move(metrics);
+    addObserver(m_metrics);
+}
+
+const std::shared_ptr<MetricsRegistry>& HttpClient::metrics() const noexcept {
+    return m_metrics;
+}
+
+void HttpClient::setCache(std::shared_ptr<HttpCache> cache) {
+    m_cache = std::move(cache);
+}
+
+const std::shared_ptr<HttpCache>& HttpClient::cache() const noexcept {
+    return m_cache;
+}
+
+void HttpClient::setConcurrencyLimiter(std::shared_ptr<ConcurrencyLimiter> limiter) {
+    m_limiter = std::move(limiter);
+}
+
+const std::shared_ptr<ConcurrencyLimiter>& HttpClient::concurrencyLimiter() const noexcept {
+    return m_limiter;
+}
+
+void HttpClient::setThrottle(std::shared_ptr<RequestThrottle> throttle) {
+    m_throttle = std::move(throttle);
+}
+
+const std::shared_ptr<RequestThrottle>& HttpClient::throttle() const noexcept {
+    return m_throttle;
+}
+
+void HttpClient::notifyObservers(const HttpRequest& httpRequest, const HttpResponse& httpResponse) {
+    for (const auto& observer : m_observers) {
+        observer->onResponse(httpRequest, httpResponse, httpResponse.timings());
+    }
+}
+
+size_t HttpClient::send(const SocketPtr& socket, const HttpRequest& httpRequest) {
     const std::string& str = httpRequest.getString();
     const char* request = str.c_str();
     const size_t length = str.length();
 
-    SocketPtr socket = getSocket(httpRequest.getUrl());
-    if(!socket){
-        return;
-    }
-
     size_t written = 0;
     while (written < length) {
         long count = socket->write(request + written, length - written);
@@ -135,71 +622,137 @@ void HttpClient::send(const HttpRequest& httpRequest) {
 
         written += static_cast<size_t>(count);
     }
+
+    return written;
 }
 
-HttpResponse HttpClient::receive(const HttpUrl& url, unsigned int timeout) {
-    std::string response = read(url, timeout);
+HttpResponse HttpClient::receive(const SocketPtr& socket, unsigned int timeout, RequestTimings& timings, const BodyReader* reader) {
+    // taken before reading, readAvailable() drains everything already buffered
+    std::string response{};
+    if (socket->waitForRead(timeout)) {
+        timings.firstByte = RequestTimings::Clock::now();
+        response = readAvailable(socket);
+    }
     
     int retry_count = 3;
     while (response.find("\r\n\r\n") == std::string::npos && retry_count) {
-        response.append(read(url, timeout));
+        response.append(read(socket, timeout));
         --retry_count;
     }
 
     HttpResponse httpResponse = response;
+    timings.bytesReceived = response.length();
 
     if (httpResponse.code() == Status::UNKNOWN) {
+        timings.lastByte = RequestTimings::Clock::now();
         return httpResponse;
     }
     
     size_t contentLen = httpResponse.contentLen();
 
-    if (contentLen >= std::numeric_limits<unsigned int>::max()) {
+    if (contentLen > m_maxResponseSize) {
         throw HttpTooBigResponse { "server response is too big!" };
     }
 
+    if (reader && httpResponse.code() >= 200 && httpResponse.code() < 300) {
+        SocketBodySource body{socket, timeout, httpResponse.takeBody(), contentLen};
+        (*reader)(httpResponse, body);
+
+        // whatever the reader left unread is drained so the connection can be reused
+        char discard[1024];
+        while (body.read(discard, sizeof(discard))) {}
+
+        timings.bytesReceived += body.received();
+        timings.lastByte = RequestTimings::Clock::now();
+        return httpResponse;
+    }
+
+    if (m_maxBodyInMemory && contentLen > m_maxBodyInMemory) {
+        timings.bytesReceived += contentLen - std::min(httpResponse.bodySize(), contentLen);
+        receiveToFile(socket, timeout, httpResponse, contentLen);
+        timings.lastByte = RequestTimings::Clock::now();
+        return httpResponse;
+    }
+
+    httpResponse.reserveBody(contentLen);
+
     size_t actual_contentLen = httpResponse.bodySize();
     while (contentLen > actual_contentLen) {
-        const std::string& data = read(url, timeout);
+        const std::string& data = read(socket, timeout);
+        if (data.empty()) {
+            throw HttpFailedToRecieve { "timed out waiting for response body" };
+        }
         actual_contentLen += data.length();
+        timings.bytesReceived += data.length();
         httpResponse.appendBody(data);
     }
 
+    timings.lastByte = RequestTimings::Clock::now();
     return httpResponse;
 }
 
-std::string HttpClient::read(const HttpUrl& url, unsigned int timeout) {
-    std::string result {};
-    
-    SocketPtr socket = getSocket(url);
-    if(!socket){
-        return "";
+void HttpClient::receiveToFile(const SocketPtr& socket, unsigned int timeout, HttpResponse& httpResponse, size_t contentLen) {
+    auto mappedBody = std::make_shared<MappedFile>(MappedFile::temporary(contentLen));
+
+    size_t received = std::min(httpResponse.bodySize(), contentLen);
+    std::memcpy(mappedBody->data(), httpResponse.body().data(), received);
+    httpResponse.setBody("");
+
+    while (contentLen > received) {
+        const std::string& data = read(socket, timeout);
+        if (data.empty()) {
+            throw HttpFailedToRecieve { "timed out waiting for response body" };
+        }
+
+        size_t count = std::min(data.length(), contentLen - received);
+        std::memcpy(mappedBody->data() + received, data.data(), count);
+        received += count;
     }
 
+    httpResponse.setMappedBody(std::move(mappedBody), received);
+}
+
+std::string HttpClient::read(const SocketPtr& socket, unsigned int timeout) {
     if (socket->waitForRead(timeout)) {
-        const static unsigned int buffSize = 1024;
-        char buff[buffSize] = {};
-        while (long count = socket->read(buff, buffSize)) {
-            if (count < 0) {
-                switch (socket->lastError()) {
-                case Socket::Error::WOULDBLOCK:
-                    return result;
-                case Socket::Error::INTERRUPTED:
-                    continue;
-                default:
-                    std::string errMsg = "Failed to recieve data : ";
-                    errMsg += socket->lastErrorString();
-                    throw HttpFailedToRecieve(errMsg);
-                }
-            }
+        return readAvailable(socket);
+    }
+
+    return {};
+}
+
+std::string HttpClient::readAvailable(const SocketPtr& socket) {
+    std::string result {};
 
-            result.append(buff, static_cast<size_t>(count));
+    const static unsigned int buffSize = 1024;
+    char buff[buffSize] = {};
+    while (long count = socket->read(buff, buffSize)) {
+        if (count < 0) {
+            switch (socket->lastError()) {
+            case Socket::Error::WOULDBLOCK:
+                return result;
+            case Socket::Error::INTERRUPTED:
+                continue;
+            default:
+                std::string errMsg = "Failed to recieve data : ";
+                errMsg += socket->lastErrorString();
+                throw HttpFailedToRecieve(errMsg);
+            }
         }
+
+        result.append(buff, static_cast<size_t>(count));
+    }
+
+    if (result.empty()) {
+        throw HttpConnClosed("connection closed by peer");
     }
 
     return result;
 }
 
+std::string HttpClient::poolKey(const HttpUrl& url) {
+    return toString(url.protocol()) + (':' + url.host());
+}
+
 HttpClient::SocketPtr HttpClient::connect(const HttpUrl& url) {
     HttpProtocol httpProtocol = url.protocol();   
     const std::string& host = url.host();
@@ -218,35 +771,27 @@ HttpClient::SocketPtr HttpClient::connect(const HttpUrl& url) {
 
     }
     
-    if(socket){
-        socket->makeNonBlocking();
+    if(!socket){
+        throw HttpConnRefused("unsupported protocol for host : " + host);
     }
-    return socket;
-}
 
-void HttpClient::disconnect(const HttpUrl& url) {
-    m_hostToSocketMap.erase(url.host());
-}
-
-HttpClient::SocketPtr HttpClient::getSocket(const HttpUrl& url){
-    std::string host = toString(url.protocol()) + (':' + url.host());
-
-    HostToSocketMap::const_iterator it = m_hostToSocketMap.find(host);
-
-    SocketPtr socket{nullptr};
-    if(it == m_hostToSocketMap.end()){
-        socket = connect(url);
-        m_hostToSocketMap[host] = socket;
-    }else{
-        socket = m_hostToSocketMap[host];
-    }
-    
+    socket->makeNonBlocking();
     return socket;
 }
 
 void swap(HttpClient& first, HttpClient& second){
     using std::swap;
-    swap(first.m_hostToSocketMap, second.m_hostToSocketMap);
+    swap(first.m_connectionPool, second.m_connectionPool);
+    swap(first.m_maxBodyInMemory, second.m_maxBodyInMemory);
+    swap(first.m_maxResponseSize, second.m_maxResponseSize);
+    swap(first.m_retryPolicy, second.m_retryPolicy);
+    swap(first.m_hedgePolicy, second.m_hedgePolicy);
+    swap(first.m_firstByteLatency, second.m_firstByteLatency);
+    swap(first.m_observers, second.m_observers);
+    swap(first.m_metrics, second.m_metrics);
+    swap(first.m_cache, second.m_cache);
+    swap(first.m_limiter, second.m_limiter);
+    swap(first.m_throttle, second.m_throttle);
 }
 
 }
@@ -1,3 +1,4 @@
+#include <stdexcept>
 #include "HttpHeader.h"
 
 namespace Http {
@@ -113,10 +114,30 @@ void HttpHeader::appendBody(const char *body, const size_t len) {
     }
 }
 
+void HttpHeader::reserveBody(size_t capacity) {
+    if (!m_body) {
+        m_body = std::make_unique<std::string>();
+    }
+    m_body->reserve(capacity);
+}
+
 size_t HttpHeader::bodySize() const noexcept {
     return (m_body ? m_body->length() : 0);
 }
 
+std::string_view HttpHeader::bodyView() const noexcept {
+    return m_body ? std::string_view{*m_body} : std::string_view{};
+}
+
+std::string HttpHeader::takeBody() {
+    std::string body{};
+    if (m_body) {
+        body = std::move(*m_body);
+        m_body.reset();
+    }
+    return body;
+}
+
 bool HttpHeader::isContainsHeader(Http::Header header) const noexcept {
     const char* header_str = toString(header);
     return m_headersMap.count(header_str) > 0;
@@ -125,7 +146,7 @@ bool HttpHeader::isContainsHeader(Http::Header header) const noexcept {
 size_t HttpHeader::contentLen() const {
     const std::string content_len = toString(Http::Header::CONTENT_LENGTH);
     const auto it = m_headersMap.find(content_len);
-    return it == m_headersMap.end() ? 0 : static_cast<size_t>(std::stoi(it->second));
+    return it == m_headersMap.end() ? 0 : static_cast<size_t>(std::stoull(it->second));
 }
 
 void HttpHeader::setHost(const std::string& host){
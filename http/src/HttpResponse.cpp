@@ -1,5 +1,9 @@
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
 #include <sstream>
 #include "HttpResponse.h"
+#include "MappedFile.h"
 
 namespace Http {
 
@@ -9,7 +13,9 @@ HttpResponse::HttpResponse(const std::string& response) : HttpHeader{} {
     parseResponse(response);
 }
 
-HttpResponse::HttpResponse(const HttpResponse& response) : HttpHeader { response }, m_status { response.m_status }, m_code { response.m_code } {}
+HttpResponse::HttpResponse(const HttpResponse& response) : HttpHeader { response }, m_status { response.m_status }, m_code { response.m_code },
+                                                            m_mappedBody { response.m_mappedBody }, m_mappedBodySize { response.m_mappedBodySize },
+                                                            m_timings { response.m_timings } {}
 
 HttpResponse::HttpResponse(HttpResponse&& response) : HttpResponse{} {
     swap(*this, response);
@@ -47,11 +53,44 @@ void HttpResponse::setStatus(const std::string& status, int code) {
     m_code = code;
 }
 
+bool HttpResponse::isBodyMapped() const noexcept {
+    return m_mappedBody != nullptr;
+}
+
+std::string_view HttpResponse::bodyView() const noexcept {
+    if (m_mappedBody) {
+        return {m_mappedBody->data(), m_mappedBodySize};
+    }
+    return HttpHeader::bodyView();
+}
+
+std::string HttpResponse::takeBody() {
+    if (m_mappedBody) {
+        std::string body{bodyView()};
+        m_mappedBody.reset();
+        m_mappedBodySize = 0;
+        return body;
+    }
+    return HttpHeader::takeBody();
+}
+
+void HttpResponse::setMappedBody(std::shared_ptr<MappedFile> mappedBody, size_t size) {
+    m_mappedBody = std::move(mappedBody);
+    m_mappedBodySize = size;
+}
+
+const RequestTimings& HttpResponse::timings() const noexcept {
+    return m_timings;
+}
+
 std::string HttpResponse::getString() const {
     std::string result{};
-    result.append(HTTP_1_1).append(" ").append(m_status).append(" ").append(std::to_string(m_code)).append(CRLF);
+    result.append(HTTP_1_1).append(" ").append(std::to_string(m_code)).append(" ").append(m_status).append(CRLF);
 
     result.append(HttpHeader::getString());
+    if (m_mappedBody) {
+        result.append(m_mappedBody->data(), m_mappedBodySize);
+    }
     return result;
 }
 
@@ -74,11 +113,15 @@ void HttpResponse::parseResponse(const std::string& response){
     std::getline(stringStream, line);
     std::vector<std::string> tokens = split(line, ' ');
 
-    if (tokens.size() < 3) {
+    // a status line that is not "version code [reason]" with a three digit
+    // code leaves the response UNKNOWN
+    if (tokens.size() < 2 || tokens[1].size() != 3 ||
+        !std::all_of(tokens[1].begin(), tokens[1].end(), [](unsigned char c) { return std::isdigit(c); })) {
         return;
     }
 
-    setStatus(tokens[2], std::stoi(tokens[1]));
+    const int code = static_cast<int>(std::strtol(tokens[1].c_str(), nullptr, 10));
+    setStatus(tokens.size() > 2 ? tokens[2] : toString(from_int(code)), code);
 
     while (std::getline(stringStream, line)) {
         if (!line.compare("\r")) {
@@ -99,6 +142,9 @@ void swap(HttpResponse& first, HttpResponse& second){
 
     swap(first.m_status, second.m_status);
     swap(first.m_code, second.m_code);
+    swap(first.m_mappedBody, second.m_mappedBody);
+    swap(first.m_mappedBodySize, second.m_mappedBodySize);
+    swap(first.m_timings, second.m_timings);
 }
 
 }
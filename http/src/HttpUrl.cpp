@@ -159,22 +159,24 @@ void HttpUrl::parseUrl(const std::string& url){
         colonPos = 0;
     }
 
+    // only the host is case insensitive, paths such as a tag name are kept
     size_t hostEnd = url.find_first_of('/', colonPos);
     m_host = changeCase(url.substr(colonPos, hostEnd - colonPos));
     if(hostEnd != std::string::npos){
-        m_endpoint = changeCase(url.substr(hostEnd));
+        m_endpoint = url.substr(hostEnd);
     }
 }
 
 void HttpUrl::parseArguments(const std::string args) {
     std::vector<std::string> url_str = split(args, ARG_DELIMETER);
     for (std::string arg_pair : url_str) {
-        std::vector<std::string> argsVec = split(arg_pair, ARG_EQUAL, true);
-        if (argsVec.size() != 2) {
-            throw std::runtime_error("invalid url format!");
+        if (arg_pair.empty()) {
+            continue;
         }
 
-        addArgument(argsVec[0], argsVec[1]);
+        // a flag without a value is an argument with an empty one
+        std::vector<std::string> argsVec = split(arg_pair, ARG_EQUAL, true);
+        addArgument(argsVec[0], argsVec.size() > 1 ? argsVec[1] : std::string{});
     }
 }
 
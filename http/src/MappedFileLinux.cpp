@@ -0,0 +1,151 @@
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include "MappedFile.h"
+
+namespace Http {
+
+[[noreturn]] static void throwFileError(const std::string& errMsg) {
+    throw std::runtime_error(errMsg + " : " + std::strerror(errno));
+}
+
+MappedFile::MappedFile() {}
+
+MappedFile::MappedFile(const std::string& path, size_t size) {
+    open(path, size, false);
+}
+
+MappedFile::MappedFile(MappedFile&& mappedFile) : MappedFile{} {
+    swap(*this, mappedFile);
+}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& mappedFile) {
+    swap(*this, mappedFile);
+
+    MappedFile temp{};
+    swap(mappedFile, temp);
+    return *this;
+}
+
+MappedFile MappedFile::temporary(size_t size) {
+    if (size == 0) {
+        throw std::invalid_argument("mapped file size cannot be zero");
+    }
+
+    const char* tmpDir = std::getenv("TMPDIR");
+    std::string pattern = (tmpDir && *tmpDir) ? tmpDir : "/tmp";
+    pattern += "/httpcpp-XXXXXX";
+
+    std::vector<char> path{pattern.begin(), pattern.end()};
+    path.push_back('\0');
+
+    int fd = mkstemp(path.data());
+    if (fd == -1) {
+        throwFileError("failed to create temporary file");
+    }
+
+    // owned from here on, closed by the destructor if mapping it fails, and
+    // gone from disk whatever happens
+    MappedFile mappedFile{};
+    mappedFile.m_fd = fd;
+    unlink(path.data());
+
+    mappedFile.map(path.data(), size);
+    return mappedFile;
+}
+
+void MappedFile::open(const std::string& path, size_t size, bool removeAfterMap) {
+    if (size == 0) {
+        throw std::invalid_argument("mapped file size cannot be zero");
+    }
+
+    m_fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0600);
+    if (m_fd == -1) {
+        throwFileError("failed to open " + path);
+    }
+
+    map(path, size);
+
+    if (removeAfterMap) {
+        unlink(path.c_str());
+    }
+}
+
+// grows the open file to size if needed and maps all of it
+void MappedFile::map(const std::string& path, size_t size) {
+    struct stat st;
+    if (fstat(m_fd, &st) == -1) {
+        close();
+        throwFileError("failed to stat " + path);
+    }
+
+    if (static_cast<size_t>(st.st_size) < size && ftruncate(m_fd, static_cast<off_t>(size)) == -1) {
+        close();
+        throwFileError("failed to resize " + path);
+    }
+
+    void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+    if (data == MAP_FAILED) {
+        close();
+        throwFileError("failed to map " + path);
+    }
+
+    m_data = static_cast<char*>(data);
+    m_size = size;
+}
+
+char* MappedFile::data() noexcept {
+    return m_data;
+}
+
+const char* MappedFile::data() const noexcept {
+    return m_data;
+}
+
+size_t MappedFile::size() const noexcept {
+    return m_size;
+}
+
+bool MappedFile::isOpen() const noexcept {
+    return m_data != nullptr;
+}
+
+void MappedFile::sync() {
+    if (m_data && msync(m_data, m_size, MS_ASYNC) == -1) {
+        throwFileError("failed to sync mapped file");
+    }
+}
+
+void MappedFile::close() {
+    if (m_data) {
+        munmap(m_data, m_size);
+        m_data = nullptr;
+        m_size = 0;
+    }
+
+    if (m_fd != -1) {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+}
+
+void swap(MappedFile& first, MappedFile& second) {
+    using std::swap;
+    swap(first.m_data, second.m_data);
+    swap(first.m_size, second.m_size);
+    swap(first.m_fd, second.m_fd);
+}
+
+}
@@ -0,0 +1,128 @@
+#include <Windows.h>
+
+#include <stdexcept>
+
+#include "MappedFile.h"
+
+namespace Http {
+
+[[noreturn]] static void throwFileError(const std::string& errMsg) {
+    throw std::runtime_error(errMsg + " : error " + std::to_string(GetLastError()));
+}
+
+MappedFile::MappedFile() {}
+
+MappedFile::MappedFile(const std::string& path, size_t size) {
+    open(path, size, false);
+}
+
+MappedFile::MappedFile(MappedFile&& mappedFile) : MappedFile{} {
+    swap(*this, mappedFile);
+}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& mappedFile) {
+    swap(*this, mappedFile);
+
+    MappedFile temp{};
+    swap(mappedFile, temp);
+    return *this;
+}
+
+MappedFile MappedFile::temporary(size_t size) {
+    char dir[MAX_PATH + 1] = {};
+    char path[MAX_PATH + 1] = {};
+
+    if (!GetTempPathA(MAX_PATH, dir) || !GetTempFileNameA(dir, "hcp", 0, path)) {
+        throwFileError("failed to create temporary file");
+    }
+
+    MappedFile mappedFile{};
+    mappedFile.open(path, size, true);
+    return mappedFile;
+}
+
+void MappedFile::open(const std::string& path, size_t size, bool removeAfterMap) {
+    if (size == 0) {
+        throw std::invalid_argument("mapped file size cannot be zero");
+    }
+
+    DWORD flags = removeAfterMap ? FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE : FILE_ATTRIBUTE_NORMAL;
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_ALWAYS, flags, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throwFileError("failed to open " + path);
+    }
+    m_file = file;
+
+    ULARGE_INTEGER mappingSize{};
+    mappingSize.QuadPart = size;
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READWRITE, mappingSize.HighPart, mappingSize.LowPart, nullptr);
+    if (mapping == nullptr) {
+        close();
+        throwFileError("failed to map " + path);
+    }
+    m_mapping = mapping;
+
+    void* data = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+    if (data == nullptr) {
+        close();
+        throwFileError("failed to map " + path);
+    }
+
+    m_data = static_cast<char*>(data);
+    m_size = size;
+}
+
+char* MappedFile::data() noexcept {
+    return m_data;
+}
+
+const char* MappedFile::data() const noexcept {
+    return m_data;
+}
+
+size_t MappedFile::size() const noexcept {
+    return m_size;
+}
+
+bool MappedFile::isOpen() const noexcept {
+    return m_data != nullptr;
+}
+
+void MappedFile::sync() {
+    if (m_data && !FlushViewOfFile(m_data, m_size)) {
+        throwFileError("failed to sync mapped file");
+    }
+}
+
+void MappedFile::close() {
+    if (m_data) {
+        UnmapViewOfFile(m_data);
+        m_data = nullptr;
+        m_size = 0;
+    }
+
+    if (m_mapping) {
+        CloseHandle(m_mapping);
+        m_mapping = nullptr;
+    }
+
+    if (m_file) {
+        CloseHandle(m_file);
+        m_file = nullptr;
+    }
+}
+
+void swap(MappedFile& first, MappedFile& second) {
+    using std::swap;
+    swap(first.m_data, second.m_data);
+    swap(first.m_size, second.m_size);
+    swap(first.m_file, second.m_file);
+    swap(first.m_mapping, second.m_mapping);
+}
+
+}
@@ -0,0 +1,75 @@
+#include "MemoryCache.h"
+
+namespace Http {
+
+MemoryCache::MemoryCache(size_t capacity) : m_capacity{capacity} {}
+
+MemoryCache::~MemoryCache() {}
+
+HttpCache::EntryPtr MemoryCache::lookup(const std::string& key) {
+    std::lock_guard<std::mutex> lock{m_mutex};
+
+    auto it = m_entries.find(key);
+    if (it == m_entries.end()) {
+        return nullptr;
+    }
+
+    m_lru.splice(m_lru.begin(), m_lru, it->second);
+    return it->second->second;
+}
+
+void MemoryCache::store(const std::string& key, EntryPtr entry) {
+    if (!entry || entry->size > m_capacity) {
+        remove(key);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock{m_mutex};
+
+    auto it = m_entries.find(key);
+    if (it != m_entries.end()) {
+        erase(it->second);
+    }
+
+    while (!m_lru.empty() && m_size + entry->size > m_capacity) {
+        erase(std::prev(m_lru.end()));
+    }
+
+    m_size += entry->size;
+    m_lru.emplace_front(key, std::move(entry));
+    m_entries[key] = m_lru.begin();
+}
+
+void MemoryCache::remove(const std::string& key) {
+    std::lock_guard<std::mutex> lock{m_mutex};
+
+    auto it = m_entries.find(key);
+    if (it != m_entries.end()) {
+        erase(it->second);
+    }
+}
+
+void MemoryCache::clear() {
+    std::lock_guard<std::mutex> lock{m_mutex};
+
+    m_entries.clear();
+    m_lru.clear();
+    m_size = 0;
+}
+
+size_t MemoryCache::size() const {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    return m_size;
+}
+
+size_t MemoryCache::capacity() const noexcept {
+    return m_capacity;
+}
+
+void MemoryCache::erase(LruList::iterator it) {
+    m_size -= it->second->size;
+    m_entries.erase(it->first);
+    m_lru.erase(it);
+}
+
+}
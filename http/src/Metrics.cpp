@@ -0,0 +1,343 @@
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <mutex>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "Metrics.h"
+#include "HttpRequest.h"
+#include "HttpResponse.h"
+
+namespace Http {
+
+// values are clamped below 2^39 microseconds, roughly six days
+static const unsigned int MAX_VALUE_BITS = 39;
+
+static const double BUCKET_BOUNDS[] = {0.001, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1, 2.5, 5, 10, 30};
+
+LatencyHistogram::LatencyHistogram() {
+    for (auto& bucket : m_buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+void LatencyHistogram::record(Duration latency) noexcept {
+    uint64_t value = static_cast<uint64_t>(std::max<Duration::rep>(latency.count(), 0));
+    value = std::min<uint64_t>(value, (uint64_t{1} << MAX_VALUE_BITS) - 1);
+
+    m_buckets[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    m_sum.fetch_add(value, std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::count() const noexcept {
+    return m_count.load(std::memory_order_relaxed);
+}
+
+LatencyHistogram::Duration LatencyHistogram::sum() const noexcept {
+    return Duration{static_cast<Duration::rep>(m_sum.load(std::memory_order_relaxed))};
+}
+
+LatencyHistogram::Duration LatencyHistogram::percentile(double percentile) const noexcept {
+    const uint64_t total = count();
+    if (total == 0) {
+        return Duration{0};
+    }
+
+    const uint64_t target = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(std::clamp(percentile, 0.0, 1.0) * static_cast<double>(total))));
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKETS; ++i) {
+        seen += m_buckets[i].load(std::memory_order_relaxed);
+        if (seen >= target) {
+            return Duration{static_cast<Duration::rep>(bucketUpperBound(i))};
+        }
+    }
+
+    return Duration{static_cast<Duration::rep>(bucketUpperBound(BUCKETS - 1))};
+}
+
+uint64_t LatencyHistogram::countAtMost(Duration bound) const noexcept {
+    const uint64_t limit = static_cast<uint64_t>(std::max<Duration::rep>(bound.count(), 0));
+
+    uint64_t result = 0;
+    for (size_t i = 0; i < BUCKETS && bucketUpperBound(i) <= limit; ++i) {
+        result += m_buckets[i].load(std::memory_order_relaxed);
+    }
+    return result;
+}
+
+size_t LatencyHistogram::bucketIndex(uint64_t value) noexcept {
+    if (value < SUB_BUCKETS) {
+        return static_cast<size_t>(value);
+    }
+
+    size_t msb = 0;
+    while (value >> (msb + 1)) {
+        ++msb;
+    }
+
+    const size_t shift = msb - SUB_BUCKET_BITS;
+    return (shift + 1) * SUB_BUCKETS + static_cast<size_t>((value >> shift) & (SUB_BUCKETS - 1));
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(size_t index) noexcept {
+    if (index < SUB_BUCKETS) {
+        return index;
+    }
+
+    const size_t shift = index / SUB_BUCKETS - 1;
+    const uint64_t lower = static_cast<uint64_t>(SUB_BUCKETS + index % SUB_BUCKETS) << shift;
+    return lower + (uint64_t{1} << shift) - 1;
+}
+
+EndpointMetrics::EndpointMetrics() {
+    for (auto& status : statuses) {
+        status.store(0, std::memory_order_relaxed);
+    }
+}
+
+void EndpointMetrics::record(const HttpResponse& response, const RequestTimings& timings) noexcept {
+    requests.fetch_add(1, std::memory_order_relaxed);
+    bytesSent.fetch_add(timings.bytesSent, std::memory_order_relaxed);
+    bytesReceived.fetch_add(timings.bytesReceived, std::memory_order_relaxed);
+
+    if (!timings.reusedConnection && timings.dnsStart != RequestTimings::Clock::time_point{}) {
+        connectionsOpened.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    const int code = response.code();
+    if (code < 0 || code >= MAX_STATUS) {
+        networkErrors.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    statuses[static_cast<size_t>(code)].fetch_add(1, std::memory_order_relaxed);
+    latency.record(timings.total());
+    timeToFirstByte.record(timings.timeToFirstByte());
+}
+
+MetricsRegistry::MetricsRegistry() {}
+
+MetricsRegistry::~MetricsRegistry() {}
+
+void MetricsRegistry::onResponse(const HttpRequest& request, const HttpResponse& response, const RequestTimings& timings) {
+    const HttpUrl& url = request.getUrl();
+
+    metricsFor(m_hosts, url.host()).record(response, timings);
+    metricsFor(m_endpoints, url.host() + ' ' + normalizeEndpoint(url.endpoint())).record(response, timings);
+}
+
+// entries are never removed, so the references handed out below stay valid
+// after the map lock is released
+EndpointMetrics& MetricsRegistry::metricsFor(MetricsMap& metrics, const std::string& key) {
+    {
+        std::shared_lock<std::shared_mutex> lock{m_mutex};
+        auto it = metrics.find(key);
+        if (it != metrics.end()) {
+            return *it->second;
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock{m_mutex};
+    std::unique_ptr<EndpointMetrics>& entry = metrics[key];
+    if (!entry) {
+        entry = std::make_unique<EndpointMetrics>();
+    }
+    return *entry;
+}
+
+std::string MetricsRegistry::normalizeEndpoint(const std::string& endpoint) {
+    // segments after these are free text chosen by the caller, tag names and
+    // media shortcodes, except for the fixed endpoints listed with them
+    static const std::vector<std::pair<std::string, std::string>> FREE_TEXT{
+        {"tags", ":tag"}, {"shortcode", ":shortcode"}
+    };
+    static const std::vector<std::string> FIXED{"search"};
+
+    std::string result{};
+    result.reserve(endpoint.length());
+
+    std::string previous{};
+    size_t start = 0;
+    while (start < endpoint.length()) {
+        size_t end = endpoint.find('/', start);
+        if (end == std::string::npos) {
+            end = endpoint.length();
+        }
+
+        std::string segment = endpoint.substr(start, end - start);
+
+        auto freeText = std::find_if(FREE_TEXT.begin(), FREE_TEXT.end(), [&previous](const std::pair<std::string, std::string>& entry) {
+            return entry.first == previous;
+        });
+
+        // instagram ids are digits, media ids are two digit runs joined by '_'
+        const bool isId = !segment.empty() && std::all_of(segment.begin(), segment.end(), [](char c) { return ::isdigit(c) || c == '_'; });
+
+        if (freeText != FREE_TEXT.end() && !segment.empty() && std::find(FIXED.begin(), FIXED.end(), segment) == FIXED.end()) {
+            segment = freeText->second;
+        } else if (isId) {
+            segment = ":id";
+        }
+
+        result.append(segment);
+        if (end < endpoint.length()) {
+            result.push_back('/');
+        }
+
+        // compared after normalization, a tag named "tags" is not taken for the
+        // prefix of the next segment
+        previous = std::move(segment);
+        start = end + 1;
+    }
+
+    return result;
+}
+
+std::vector<MetricsSnapshot> MetricsRegistry::hostSnapshot() const {
+    return snapshot(m_hosts);
+}
+
+std::vector<MetricsSnapshot> MetricsRegistry::endpointSnapshot() const {
+    return snapshot(m_endpoints);
+}
+
+std::vector<MetricsSnapshot> MetricsRegistry::snapshot(const MetricsMap& metrics) const {
+    std::shared_lock<std::shared_mutex> lock{m_mutex};
+
+    std::vector<MetricsSnapshot> result{};
+    result.reserve(metrics.size());
+
+    for (const auto& p : metrics) {
+        const EndpointMetrics& entry = *p.second;
+
+        MetricsSnapshot snapshot{};
+        size_t separator = p.first.find(' ');
+        snapshot.host = p.first.substr(0, separator);
+        if (separator != std::string::npos) {
+            snapshot.endpoint = p.first.substr(separator + 1);
+        }
+
+        snapshot.requests = entry.requests.load(std::memory_order_relaxed);
+        snapshot.networkErrors = entry.networkErrors.load(std::memory_order_relaxed);
+        snapshot.connectionsOpened = entry.connectionsOpened.load(std::memory_order_relaxed);
+        snapshot.bytesSent = entry.bytesSent.load(std::memory_order_relaxed);
+        snapshot.bytesReceived = entry.bytesReceived.load(std::memory_order_relaxed);
+
+        for (int code = 0; code < EndpointMetrics::MAX_STATUS; ++code) {
+            uint64_t count = entry.statuses[static_cast<size_t>(code)].load(std::memory_order_relaxed);
+            if (count) {
+                snapshot.statuses[code] = count;
+            }
+        }
+
+        snapshot.p50 = entry.latency.percentile(0.5);
+        snapshot.p90 = entry.latency.percentile(0.9);
+        snapshot.p99 = entry.latency.percentile(0.99);
+
+        result.push_back(std::move(snapshot));
+    }
+
+    std::sort(result.begin(), result.end(), [](const MetricsSnapshot& first, const MetricsSnapshot& second) {
+        return std::tie(first.host, first.endpoint) < std::tie(second.host, second.endpoint);
+    });
+
+    return result;
+}
+
+static std::string escapeLabel(const std::string& value) {
+    std::string result{};
+    for (char c : value) {
+        if (c == '\\' || c == '"') {
+            result.push_back('\\');
+        }
+        result.push_back(c == '\n' ? ' ' : c);
+    }
+    return result;
+}
+
+static void appendSample(std::string& out, const std::string& name, const std::string& labels, const std::string& value) {
+    out.append(name).append("{").append(labels).append("} ").append(value).append("\n");
+}
+
+static void appendHistogram(std::string& out, const std::string& name, const std::string& labels, const LatencyHistogram& histogram) {
+    for (double bound : BUCKET_BOUNDS) {
+        const auto micros = LatencyHistogram::Duration{static_cast<LatencyHistogram::Duration::rep>(bound * 1e6)};
+
+        std::string le = std::to_string(bound);
+        le.erase(le.find_last_not_of('0') + 1);
+        if (le.back() == '.') {
+            le.pop_back();
+        }
+
+        appendSample(out, name + "_bucket", labels + ",le=\"" + le + "\"", std::to_string(histogram.countAtMost(micros)));
+    }
+
+    appendSample(out, name + "_bucket", labels + ",le=\"+Inf\"", std::to_string(histogram.count()));
+    appendSample(out, name + "_sum", labels, std::to_string(std::chrono::duration<double>(histogram.sum()).count()));
+    appendSample(out, name + "_count", labels, std::to_string(histogram.count()));
+}
+
+void MetricsRegistry::exportMetrics(std::string& out, const MetricsMap& metrics, const std::string& prefix) const {
+    std::vector<std::pair<std::string, const EndpointMetrics*>> entries{};
+    {
+        std::shared_lock<std::shared_mutex> lock{m_mutex};
+        for (const auto& p : metrics) {
+            std::string labels{};
+
+            size_t separator = p.first.find(' ');
+            labels.append("host=\"").append(escapeLabel(p.first.substr(0, separator))).append("\"");
+            if (separator != std::string::npos) {
+                labels.append(",endpoint=\"").append(escapeLabel(p.first.substr(separator + 1))).append("\"");
+            }
+
+            entries.emplace_back(std::move(labels), p.second.get());
+        }
+    }
+    std::sort(entries.begin(), entries.end());
+
+    auto counter = [&](const std::string& name, std::atomic<uint64_t> EndpointMetrics::*member) {
+        out.append("# TYPE ").append(prefix).append(name).append(" counter\n");
+        for (const auto& entry : entries) {
+            appendSample(out, prefix + name, entry.first, std::to_string((entry.second->*member).load(std::memory_order_relaxed)));
+        }
+    };
+
+    counter("_requests_total", &EndpointMetrics::requests);
+    counter("_network_errors_total", &EndpointMetrics::networkErrors);
+    counter("_connections_opened_total", &EndpointMetrics::connectionsOpened);
+    counter("_sent_bytes_total", &EndpointMetrics::bytesSent);
+    counter("_received_bytes_total", &EndpointMetrics::bytesReceived);
+
+    out.append("# TYPE ").append(prefix).append("_responses_total counter\n");
+    for (const auto& entry : entries) {
+        for (int code = 0; code < EndpointMetrics::MAX_STATUS; ++code) {
+            uint64_t count = entry.second->statuses[static_cast<size_t>(code)].load(std::memory_order_relaxed);
+            if (count) {
+                appendSample(out, prefix + "_responses_total", entry.first + ",code=\"" + std::to_string(code) + "\"", std::to_string(count));
+            }
+        }
+    }
+
+    out.append("# TYPE ").append(prefix).append("_request_duration_seconds histogram\n");
+    for (const auto& entry : entries) {
+        appendHistogram(out, prefix + "_request_duration_seconds", entry.first, entry.second->latency);
+    }
+
+    out.append("# TYPE ").append(prefix).append("_time_to_first_byte_seconds histogram\n");
+    for (const auto& entry : entries) {
+        appendHistogram(out, prefix + "_time_to_first_byte_seconds", entry.first, entry.second->timeToFirstByte);
+    }
+}
+
+std::string MetricsRegistry::exportText() const {
+    std::string result{};
+    exportMetrics(result, m_hosts, "http_client_host");
+    exportMetrics(result, m_endpoints, "http_client_endpoint");
+    return result;
+}
+
+}
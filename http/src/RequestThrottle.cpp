@@ -0,0 +1,11 @@
+#include "RequestThrottle.h"
+
+namespace Http {
+
+RequestThrottle::~RequestThrottle() {}
+
+bool RequestThrottle::tryPass(const HttpRequest&) {
+    return true;
+}
+
+}
@@ -0,0 +1,39 @@
+#include "RequestTimings.h"
+
+namespace Http {
+
+static RequestTimings::Duration between(RequestTimings::Clock::time_point from, RequestTimings::Clock::time_point to) {
+    if (from == RequestTimings::Clock::time_point{} || to < from) {
+        return RequestTimings::Duration{0};
+    }
+
+    return std::chrono::duration_cast<RequestTimings::Duration>(to - from);
+}
+
+RequestTimings::Duration RequestTimings::dns() const noexcept {
+    return between(dnsStart, dnsEnd);
+}
+
+RequestTimings::Duration RequestTimings::connect() const noexcept {
+    return between(dnsEnd, connectEnd);
+}
+
+RequestTimings::Duration RequestTimings::tls() const noexcept {
+    return between(connectEnd, tlsEnd);
+}
+
+RequestTimings::Duration RequestTimings::timeToFirstByte() const noexcept {
+    return between(requestSent, firstByte);
+}
+
+RequestTimings::Duration RequestTimings::transfer() const noexcept {
+    return between(firstByte, lastByte);
+}
+
+RequestTimings::Duration RequestTimings::total() const noexcept {
+    return between(start, lastByte);
+}
+
+RequestObserver::~RequestObserver() {}
+
+}
@@ -0,0 +1,156 @@
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <ctime>
+#include <limits>
+#include <random>
+
+#include "RetryPolicy.h"
+#include "HttpRequest.h"
+#include "HttpResponse.h"
+
+namespace Http {
+
+static RetryPolicy::Duration::rep randomBetween(RetryPolicy::Duration::rep from, RetryPolicy::Duration::rep to) {
+    thread_local std::mt19937_64 engine{std::random_device{}()};
+    std::uniform_int_distribution<RetryPolicy::Duration::rep> distribution{from, std::max(from, to)};
+    return distribution(engine);
+}
+
+RetryPolicy::RetryPolicy() {}
+
+RetryPolicy::RetryPolicy(unsigned int maxAttempts, Duration baseDelay, Duration maxDelay) : m_maxAttempts{std::max(maxAttempts, 1u)},
+                                                                                            m_baseDelay{baseDelay},
+                                                                                            m_maxDelay{maxDelay} {}
+
+RetryPolicy RetryPolicy::disabled() {
+    return RetryPolicy{1, Duration{0}, Duration{0}};
+}
+
+void RetryPolicy::setMaxAttempts(unsigned int attempts) {
+    m_maxAttempts = std::max(attempts, 1u);
+}
+
+unsigned int RetryPolicy::maxAttempts() const noexcept {
+    return m_maxAttempts;
+}
+
+void RetryPolicy::setBaseDelay(Duration delay) {
+    m_baseDelay = delay;
+}
+
+RetryPolicy::Duration RetryPolicy::baseDelay() const noexcept {
+    return m_baseDelay;
+}
+
+void RetryPolicy::setMaxDelay(Duration delay) {
+    m_maxDelay = delay;
+}
+
+RetryPolicy::Duration RetryPolicy::maxDelay() const noexcept {
+    return m_maxDelay;
+}
+
+void RetryPolicy::setRetryableStatuses(const std::set<int>& statuses) {
+    m_retryableStatuses = statuses;
+}
+
+const std::set<int>& RetryPolicy::retryableStatuses() const noexcept {
+    return m_retryableStatuses;
+}
+
+void RetryPolicy::setRetryOnNetworkError(bool retry) {
+    m_retryOnNetworkError = retry;
+}
+
+bool RetryPolicy::retryOnNetworkError() const noexcept {
+    return m_retryOnNetworkError;
+}
+
+void RetryPolicy::setHonorRetryAfter(bool honor) {
+    m_honorRetryAfter = honor;
+}
+
+bool RetryPolicy::honorRetryAfter() const noexcept {
+    return m_honorRetryAfter;
+}
+
+void RetryPolicy::setIdempotentOnly(bool idempotentOnly) {
+    m_idempotentOnly = idempotentOnly;
+}
+
+bool RetryPolicy::idempotentOnly() const noexcept {
+    return m_idempotentOnly;
+}
+
+bool RetryPolicy::shouldRetry(const HttpRequest& request, const HttpResponse& response, bool networkError, unsigned int attempt) const {
+    if (attempt >= m_maxAttempts) {
+        return false;
+    }
+
+    if (m_idempotentOnly && !isIdempotent(request.method())) {
+        return false;
+    }
+
+    if (networkError) {
+        return m_retryOnNetworkError;
+    }
+
+    if (!m_retryableStatuses.count(response.code())) {
+        return false;
+    }
+
+    // a server asking to come back later than we are willing to wait gets its
+    // response handed to the caller right away
+    return retryAfter(response) <= m_maxDelay;
+}
+
+RetryPolicy::Duration RetryPolicy::nextDelay(const HttpResponse& response, Duration previous) const {
+    const Duration::rep base = m_baseDelay.count();
+
+    const Duration after = retryAfter(response);
+    if (after.count() > 0) {
+        return Duration{after.count() + randomBetween(0, base)};
+    }
+
+    const Duration::rep upper = std::max(previous.count(), base) * 3;
+    return std::min(Duration{randomBetween(base, upper)}, m_maxDelay);
+}
+
+RetryPolicy::Duration RetryPolicy::retryAfter(const HttpResponse& response) const {
+    if (!m_honorRetryAfter) {
+        return Duration{0};
+    }
+
+    const std::string& value = response[Header::RETRY_AFTER];
+    if (value.empty()) {
+        return Duration{0};
+    }
+
+    if (std::all_of(value.begin(), value.end(), [](unsigned char c) { return std::isdigit(c); })) {
+        errno = 0;
+        const long long seconds = std::strtoll(value.c_str(), nullptr, 10);
+        return errno == ERANGE ? clampDelay(std::numeric_limits<long long>::max()) : clampDelay(seconds);
+    }
+
+    std::time_t date = parseHttpDate(value);
+    std::time_t now = std::time(nullptr);
+    if (date == -1 || date <= now) {
+        return Duration{0};
+    }
+
+    return clampDelay(date - now);
+}
+
+// Anything longer than the max delay comes back one tick past it, enough for
+// shouldRetry() to turn it down without overflowing the conversion.
+RetryPolicy::Duration RetryPolicy::clampDelay(long long seconds) const {
+    if (seconds >= std::chrono::duration_cast<std::chrono::seconds>(m_maxDelay).count() + 1) {
+        return m_maxDelay + Duration{1};
+    }
+
+    return std::chrono::duration_cast<Duration>(std::chrono::seconds{seconds});
+}
+
+}
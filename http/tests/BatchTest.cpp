@@ -0,0 +1,84 @@
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "Check.hpp"
+#include "FanOut.h"
+#include "HttpClient.h"
+#include "HttpRequest.h"
+#include "HttpResponse.h"
+#include "RequestThrottle.h"
+#include "RetryPolicy.h"
+
+// An exception thrown on a worker thread has to reach the caller of the batch
+// instead of terminating the process.
+
+using namespace Http;
+
+namespace {
+
+class FailingThrottle : public RequestThrottle {
+public:
+    void wait(const HttpRequest& request) override {
+        if (request.getUrl().url().find("fail") != std::string::npos) {
+            throw std::runtime_error{"throttle failed"};
+        }
+    }
+};
+
+void testFanOut(){
+    std::vector<int> done(64, 0);
+    fanOut(done.size(), 8, [&done](size_t i) {
+        done[i] = 1;
+    });
+    CHECK(std::count(done.begin(), done.end(), 1) == 64);
+
+    std::atomic<int> ran{0};
+    bool caught = false;
+    try {
+        fanOut(64, 8, [&ran](size_t i) {
+            ++ran;
+            if (i == 3) {
+                throw std::runtime_error{"task failed"};
+            }
+        });
+    } catch (const std::runtime_error& error) {
+        caught = std::string{error.what()} == "task failed";
+    }
+    CHECK(caught);
+    CHECK(ran > 0 && ran <= 64);
+}
+
+void testSendBatch(){
+    HttpClient client{};
+    client.setRetryPolicy(RetryPolicy::disabled());
+    client.setThrottle(std::make_shared<FailingThrottle>());
+
+    // nothing listens on port 1, the requests that get through fail fast
+    std::vector<HttpRequest> requests{};
+    for (const char* endpoint : {"/a", "/fail", "/b", "/c"}) {
+        requests.emplace_back(HttpUrl{std::string{"http://127.0.0.1:1"} + endpoint});
+    }
+
+    bool caught = false;
+    try {
+        client.sendBatch(requests, 4);
+    } catch (const std::runtime_error& error) {
+        caught = std::string{error.what()} == "throttle failed";
+    }
+    CHECK(caught);
+
+    const std::vector<HttpResponse> responses = client.sendBatch({requests[0], requests[2]}, 2);
+    CHECK(responses.size() == 2);
+}
+
+}
+
+int main(){
+    testFanOut();
+    testSendBatch();
+
+    return Tests::checkResult();
+}
@@ -0,0 +1,36 @@
+#ifndef HTTP_TESTS_CHECK_HPP
+#define HTTP_TESTS_CHECK_HPP
+
+#include <iostream>
+
+// Failed checks are reported and counted, the test carries on and fails at
+// the end of main with checkResult().
+#define CHECK(condition) Http::Tests::check((condition), #condition, __FILE__, __LINE__)
+
+namespace Http{
+namespace Tests{
+
+inline int& failures(){
+    static int count = 0;
+    return count;
+}
+
+inline void check(bool condition, const char* expression, const char* file, int line){
+    if(!condition){
+        ++failures();
+        std::cerr << file << ":" << line << ": " << expression << " failed" << std::endl;
+    }
+}
+
+inline int checkResult(){
+    if(failures() != 0){
+        std::cerr << failures() << " checks failed" << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+}
+}
+
+#endif
@@ -0,0 +1,111 @@
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "Check.hpp"
+#include "DiskCache.h"
+
+// Entries survive a reopen of the directory, while neither the urls nor the
+// access tokens in them end up on disk, and nobody but the owner can read the files.
+
+using namespace Http;
+
+namespace {
+
+const std::string KEY{"https://api.instagram.com/v1/users/self?access_token=secret-token"};
+const std::string OTHER_KEY{"https://api.instagram.com/v1/users/self?access_token=other-token"};
+
+class TemporaryDirectory{
+public:
+    TemporaryDirectory(){
+        char path[] = "/tmp/disk_cache_test.XXXXXX";
+        m_path = mkdtemp(path) ? path : "";
+    }
+
+    ~TemporaryDirectory(){
+        std::remove(file("index").c_str());
+        for (int segment = 0; segment < 4; ++segment) {
+            std::remove(file("segment-" + std::to_string(segment)).c_str());
+        }
+        rmdir(m_path.c_str());
+    }
+
+    const std::string& path() const noexcept {
+        return m_path;
+    }
+
+    std::string file(const std::string& name) const {
+        return m_path + "/" + name;
+    }
+private:
+    std::string m_path;
+};
+
+HttpCache::EntryPtr entry(const std::string& body){
+    HttpResponse response{};
+    response = "HTTP/1.1 200 OK\r\nCache-Control: max-age=600\r\nContent-Length: " + std::to_string(body.length()) + "\r\n\r\n" + body;
+    return CacheEntry::create(response, std::time(nullptr));
+}
+
+std::string content(const std::string& path){
+    std::ifstream file{path, std::ios::binary};
+    return std::string{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+}
+
+bool ownerOnly(const std::string& path){
+    struct stat st{};
+    return stat(path.c_str(), &st) == 0 && (st.st_mode & 0777) == 0600;
+}
+
+void testRoundTrip(){
+    TemporaryDirectory directory{};
+    CHECK(!directory.path().empty());
+
+    {
+        DiskCache cache{directory.path()};
+        cache.store(KEY, entry("first"));
+        cache.store(OTHER_KEY, entry("second"));
+        CHECK(cache.entryCount() == 2);
+
+        const HttpCache::EntryPtr found = cache.lookup(KEY);
+        CHECK(found && found->response.bodyView() == "first");
+        CHECK(cache.lookup("https://api.instagram.com/v1/users/self") == nullptr);
+    }
+
+    // a new instance on the same directory starts warm
+    DiskCache reopened{directory.path()};
+    const HttpCache::EntryPtr found = reopened.lookup(OTHER_KEY);
+    CHECK(found && found->response.bodyView() == "second");
+
+    reopened.remove(OTHER_KEY);
+    CHECK(reopened.lookup(OTHER_KEY) == nullptr);
+    CHECK(reopened.lookup(KEY) != nullptr);
+}
+
+void testFiles(){
+    TemporaryDirectory directory{};
+    {
+        DiskCache cache{directory.path()};
+        cache.store(KEY, entry("body"));
+    }
+
+    for (const std::string name : {"index", "segment-0"}) {
+        CHECK(ownerOnly(directory.file(name)));
+
+        const std::string bytes = content(directory.file(name));
+        CHECK(bytes.find("secret-token") == std::string::npos);
+        CHECK(bytes.find("users/self") == std::string::npos);
+    }
+}
+
+}
+
+int main(){
+    testRoundTrip();
+    testFiles();
+
+    return Tests::checkResult();
+}
@@ -0,0 +1,96 @@
+#include <ctime>
+#include <string>
+#include "Check.hpp"
+#include "HttpCache.h"
+#include "HttpRequest.h"
+#include "HttpResponse.h"
+#include "RetryPolicy.h"
+
+// Header values come from the server, none of them may throw or overflow
+// however they look.
+
+using namespace Http;
+
+namespace {
+
+const std::string HUGE_NUMBER{"99999999999999999999999999"};
+
+HttpResponse response(const std::string& raw){
+    HttpResponse httpResponse{};
+    httpResponse = raw;
+    return httpResponse;
+}
+
+HttpResponse withHeader(int code, Header header, const std::string& value){
+    HttpResponse httpResponse{};
+    httpResponse.setStatus("", code);
+    httpResponse[header] = value;
+    return httpResponse;
+}
+
+void testStatusLine(){
+    const HttpResponse ok = response("HTTP/1.1 200 OK\r\nContent-Length: 2\r\n\r\nok");
+    CHECK(ok.code() == 200);
+    CHECK(ok.status() == "OK");
+    CHECK(ok.bodyView() == "ok");
+
+    // the reason phrase is optional
+    const HttpResponse noReason = response("HTTP/1.1 429\r\n\r\n");
+    CHECK(noReason.code() == 429);
+    CHECK(noReason.status() == toString(Status::TOO_MANY_REQUESTS));
+
+    CHECK(response("HTTP/1.1 " + HUGE_NUMBER + " OK\r\n\r\n").code() == Status::UNKNOWN);
+    CHECK(response("HTTP/1.1 2x0 OK\r\n\r\n").code() == Status::UNKNOWN);
+    CHECK(response("garbage\r\n\r\n").code() == Status::UNKNOWN);
+}
+
+void testRetryAfter(){
+    RetryPolicy policy{3, RetryPolicy::Duration{0}, RetryPolicy::Duration{10000}};
+    const HttpRequest request{HttpUrl{"http://example.com/"}};
+
+    const HttpResponse seconds = withHeader(503, Header::RETRY_AFTER, "5");
+    CHECK(policy.shouldRetry(request, seconds, false, 1));
+    CHECK(policy.nextDelay(seconds, RetryPolicy::Duration{0}) == RetryPolicy::Duration{5000});
+
+    // longer than the policy waits, handed back instead of retried
+    const HttpResponse huge = withHeader(503, Header::RETRY_AFTER, HUGE_NUMBER);
+    CHECK(!policy.shouldRetry(request, huge, false, 1));
+    CHECK(policy.nextDelay(huge, RetryPolicy::Duration{0}) > policy.maxDelay());
+
+    const HttpResponse tooLong = withHeader(503, Header::RETRY_AFTER, "11");
+    CHECK(!policy.shouldRetry(request, tooLong, false, 1));
+
+    // neither seconds nor a date counts as absent
+    const HttpResponse garbage = withHeader(503, Header::RETRY_AFTER, "soon");
+    CHECK(policy.shouldRetry(request, garbage, false, 1));
+}
+
+void testCacheHeaders(){
+    CHECK(CacheControl::parse("max-age=60").maxAge == 60);
+    CHECK(CacheControl::parse("no-store, max-age=60").noStore);
+    CHECK(CacheControl::parse("max-age=" + HUGE_NUMBER).maxAge == 2147483647);
+    CHECK(CacheControl::parse("max-age=-1").maxAge == -1);
+    CHECK(CacheControl::parse("max-age=abc").maxAge == -1);
+
+    const std::time_t now = std::time(nullptr);
+
+    HttpResponse aged = withHeader(200, Header::CACHE_CONTROL, "max-age=60");
+    aged[Header::AGE] = HUGE_NUMBER;
+    const HttpCache::EntryPtr agedEntry = CacheEntry::create(aged, now);
+    CHECK(agedEntry && agedEntry->initialAge == 2147483647);
+    CHECK(agedEntry && !agedEntry->isFresh(now));
+
+    // a malformed max-age without any other freshness information or a
+    // validator is not cached
+    CHECK(CacheEntry::create(withHeader(200, Header::CACHE_CONTROL, "max-age=abc"), now) == nullptr);
+}
+
+}
+
+int main(){
+    testStatusLine();
+    testRetryAfter();
+    testCacheHeaders();
+
+    return Tests::checkResult();
+}
@@ -0,0 +1,50 @@
+#include <string>
+#include "Check.hpp"
+#include "HttpRequest.h"
+#include "HttpResponse.h"
+#include "Metrics.h"
+
+// Every id or name a caller puts into a path would otherwise grow its own
+// series, and with it the exported metrics, without bound.
+
+using namespace Http;
+
+namespace {
+
+void testNormalizeEndpoint(){
+    CHECK(MetricsRegistry::normalizeEndpoint("/v1/users/1574083/media/recent") == "/v1/users/:id/media/recent");
+    CHECK(MetricsRegistry::normalizeEndpoint("/v1/media/1234_5678/comments") == "/v1/media/:id/comments");
+    CHECK(MetricsRegistry::normalizeEndpoint("/v1/users/self/feed") == "/v1/users/self/feed");
+
+    CHECK(MetricsRegistry::normalizeEndpoint("/v1/tags/nyc") == "/v1/tags/:tag");
+    CHECK(MetricsRegistry::normalizeEndpoint("/v1/tags/snowy_day2016/media/recent") == "/v1/tags/:tag/media/recent");
+    CHECK(MetricsRegistry::normalizeEndpoint("/v1/tags/tags/media/recent") == "/v1/tags/:tag/media/recent");
+    CHECK(MetricsRegistry::normalizeEndpoint("/v1/tags/search") == "/v1/tags/search");
+    CHECK(MetricsRegistry::normalizeEndpoint("/v1/media/shortcode/BWrVZ") == "/v1/media/shortcode/:shortcode");
+}
+
+void testOneSeriesPerEndpoint(){
+    MetricsRegistry metrics{};
+
+    HttpResponse response{};
+    response.setStatus("OK", 200);
+
+    for (const char* tag : {"nyc", "paris", "snow"}) {
+        const HttpRequest request{HttpUrl{std::string{"https://api.instagram.com/v1/tags/"} + tag + "/media/recent"}};
+        metrics.onResponse(request, response, RequestTimings{});
+    }
+
+    const std::vector<MetricsSnapshot> endpoints = metrics.endpointSnapshot();
+    CHECK(endpoints.size() == 1);
+    CHECK(!endpoints.empty() && endpoints[0].endpoint == "/v1/tags/:tag/media/recent");
+    CHECK(!endpoints.empty() && endpoints[0].requests == 3);
+}
+
+}
+
+int main(){
+    testNormalizeEndpoint();
+    testOneSeriesPerEndpoint();
+
+    return Tests::checkResult();
+}
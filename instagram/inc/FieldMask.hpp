@@ -0,0 +1,83 @@
+#ifndef INSTAGRAM_FIELD_MASK_HPP
+#define INSTAGRAM_FIELD_MASK_HPP
+
+#include <cstdint>
+
+namespace Instagram{
+
+constexpr uint64_t ALL_FIELDS = ~uint64_t{0};
+
+enum class MediaField : uint64_t{
+    ID = 1 << 0,
+    TYPE = 1 << 1,
+    LINK = 1 << 2,
+    FILTER = 1 << 3,
+    CREATE_TIME = 1 << 4,
+    CAPTION = 1 << 5,
+    IMAGES = 1 << 6,
+    VIDEOS = 1 << 7,
+    COMMENTS_COUNT = 1 << 8,
+    LIKES_COUNT = 1 << 9,
+    TAGS = 1 << 10,
+    USERS_IN_PHOTO = 1 << 11,
+    USER = 1 << 12
+};
+
+enum class UserField : uint64_t{
+    ID = 1 << 0,
+    USERNAME = 1 << 1,
+    PROFILE_PICTURE = 1 << 2,
+    FULL_NAME = 1 << 3,
+    BIO = 1 << 4,
+    WEBSITE = 1 << 5,
+    COUNTS = 1 << 6
+};
+
+// The members of a result the parsers fill in, json of the others is skipped
+// without being turned into strings. Default constructed masks select every
+// field, combine single fields with |.
+template<typename Field>
+class FieldMask{
+public:
+    constexpr FieldMask() noexcept : m_bits{ALL_FIELDS} {}
+    constexpr FieldMask(Field field) noexcept : m_bits{static_cast<uint64_t>(field)} {}
+
+    constexpr FieldMask operator|(FieldMask mask) const noexcept{
+        return FieldMask{m_bits | mask.m_bits, 0};
+    }
+
+    constexpr bool contains(FieldMask mask) const noexcept{
+        return (m_bits & mask.m_bits) == mask.m_bits;
+    }
+
+    constexpr uint64_t bits() const noexcept{
+        return m_bits;
+    }
+
+    constexpr bool operator==(FieldMask mask) const noexcept{
+        return m_bits == mask.m_bits;
+    }
+
+    constexpr bool operator!=(FieldMask mask) const noexcept{
+        return m_bits != mask.m_bits;
+    }
+private:
+    constexpr FieldMask(uint64_t bits, int) noexcept : m_bits{bits} {}
+
+    uint64_t m_bits;
+};
+
+using MediaFields = FieldMask<MediaField>;
+using UserFields = FieldMask<UserField>;
+
+constexpr MediaFields operator|(MediaField first, MediaField second) noexcept{
+    return MediaFields{first} | second;
+}
+
+constexpr UserFields operator|(UserField first, UserField second) noexcept{
+    return UserFields{first} | second;
+}
+
+}
+
+#endif
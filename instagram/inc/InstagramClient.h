@@ -5,20 +5,31 @@
 
 #include "AuthorizationToken.h"
 #include "MediaEntries.h"
+#include "ArenaMediaEntries.h"
+#include "MediaEntryViews.h"
 #include "UsersInfo.h"
 #include "RelationshipInfo.h"
 #include "TagsInfo.h"
 #include "CommentsInfo.h"
 #include "LocationsInfo.h"
 
+#include "FieldMask.hpp"
 #include "InstagramDefinitions.h"
+#include "PageRange.hpp"
+#include "RateLimitScheduler.h"
+#include "SingleFlight.hpp"
 
 namespace Instagram{
 
+// API calls may be made from several threads at once, setters are meant to be
+// called before that.
 class EXPORT_INSTAGRAM InstagramClient{
 public:
     InstagramClient();
     InstagramClient(const std::string& authToken);
+    // Clients sharing an HttpClient share its connections along with everything
+    // the setters below configure on it.
+    InstagramClient(const std::string& authToken, std::shared_ptr<Http::HttpClient> httpClient);
     InstagramClient(InstagramClient& instServ) = delete;
     InstagramClient(InstagramClient&& instServ);
 
@@ -27,56 +38,111 @@ public:
     void setAuthToken(const std::string& authToken);
     const std::string& getAuthToken() const;
 
+    // Single user and media lookups are hedged when the policy is enabled.
+    void setHedgePolicy(const Http::HedgePolicy& hedgePolicy);
+
+    // Every request made through this client is recorded in the registry.
+    void setMetrics(std::shared_ptr<Http::MetricsRegistry> metrics);
+    const std::shared_ptr<Http::MetricsRegistry>& metrics() const noexcept;
+
+    // Repeated lookups of the same url are answered from the cache while the
+    // API marks them fresh.
+    void setCache(std::shared_ptr<Http::HttpCache> cache);
+
+    // Bounds the requests in flight, most useful together with the batch lookups.
+    void setConcurrencyLimiter(std::shared_ptr<Http::ConcurrencyLimiter> limiter);
+
+    // Paces the requests of every access token to its rate limit budget, share
+    // one scheduler between all clients using the same token.
+    void setRateLimitScheduler(std::shared_ptr<RateLimitScheduler> scheduler);
+    const std::shared_ptr<RateLimitScheduler>& rateLimitScheduler() const noexcept;
+
+    // Arena pages, returned by the InArena calls, get an arena starting at
+    // initialSize bytes that holds all of the page and is released at once
+    // with it, 0 means PAGE_ARENA_SIZE.
+    void setPageArenaSize(size_t initialSize);
+
 //API's
+    // Calls returning users or media take the fields to parse, leaving out
+    // what is not needed saves parsing and memory.
     AuthorizationToken authenticate(const std::string& code,
                                      const std::string& clientId,
                                      const std::string& clientSecret,
                                      const std::string& redirectUri);
 //Users
-    UserInfo getUserInfo() const;
-    UserInfo getUserInfo(const std::string& userId) const;
-    MediaEntries getRecentMedia(unsigned count = 20) const;
-    MediaEntries getRecentMedia(const std::string& minId, const std::string& maxId, unsigned count = 20) const;
-    MediaEntries getRecentMedia(const std::string& userId, const std::string& minId, const std::string& maxId, unsigned count = 20) const;
-    MediaEntries getRecentMedia(const std::string& userId, unsigned count = 20) const;
-    MediaEntries getLikedMedia(unsigned int count = 20) const;
-    MediaEntries getLikedMedia(const std::string& maxId, unsigned int count = 20)const;
-    UsersInfo searchUsers(const std::string& query, unsigned count = 20) const;
+    UserInfo getUserInfo(UserFields fields = {}) const;
+    UserInfo getUserInfo(const std::string& userId, UserFields fields = {}) const;
+    // Fetched concurrently, the result keeps the order of the ids and holds an
+    // error result for every id that failed.
+    UsersInfo getUsersInfo(const std::vector<std::string>& userIds, UserFields fields = {}) const;
+    MediaEntries getRecentMedia(unsigned count = 20, MediaFields fields = {}) const;
+    MediaEntries getRecentMedia(const std::string& minId, const std::string& maxId, unsigned count = 20, MediaFields fields = {}) const;
+    MediaEntries getRecentMedia(const std::string& userId, const std::string& minId, const std::string& maxId, unsigned count = 20, MediaFields fields = {}) const;
+    MediaEntries getRecentMedia(const std::string& userId, unsigned count = 20, MediaFields fields = {}) const;
+    // Read only pages pointing into the response instead of copying strings
+    // out of it, see MediaEntryView.
+    MediaEntryViews getRecentMediaViews(const std::string& userId, unsigned count = 20, MediaFields fields = {}) const;
+    // Pages allocated from one arena, see ArenaMediaEntry.
+    ArenaMediaEntries getRecentMediaInArena(const std::string& userId, unsigned count = 20, MediaFields fields = {}) const;
+    MediaEntries getLikedMedia(unsigned int count = 20, MediaFields fields = {}) const;
+    MediaEntries getLikedMedia(const std::string& maxId, unsigned int count = 20, MediaFields fields = {})const;
+    UsersInfo searchUsers(const std::string& query, unsigned count = 20, UserFields fields = {}) const;
 //Relationships
-    UsersInfo getFollows() const;
-    UsersInfo getFollowedBy() const;
-    UsersInfo getRequestedBy() const;
+    UsersInfo getFollows(UserFields fields = {}) const;
+    UsersInfo getFollowedBy(UserFields fields = {}) const;
+    UsersInfo getRequestedBy(UserFields fields = {}) const;
     RelationshipInfo getRelationshipInfo(const std::string& userId) const;
     RelationshipInfo follow(const std::string& userId);
     RelationshipInfo unfollow(const std::string& userId);
     RelationshipInfo approve(const std::string& userId);
     RelationshipInfo ignore(const std::string& userId);
 //Media
-    MediaEntry getMedia(const std::string& mediaId) const;
-    MediaEntry getMediaWithShortCode(const std::string& shortcode) const;
-    MediaEntries searchMedia(double lat, double lng, int distance = 1000) const;
+    MediaEntry getMedia(const std::string& mediaId, MediaFields fields = {}) const;
+    MediaEntries getMedia(const std::vector<std::string>& mediaIds, MediaFields fields = {}) const;
+    MediaEntry getMediaWithShortCode(const std::string& shortcode, MediaFields fields = {}) const;
+    MediaEntries searchMedia(double lat, double lng, int distance = 1000, MediaFields fields = {}) const;
 //Comments
     CommentsInfo getComments(const std::string& mediaId) const;
     BaseResult comment(const std::string& mediaId, const std::string& text);
     BaseResult deleteComment(const std::string& mediaId, const std::string& commentId);
 //Likes
-    UsersInfo getLikes(const std::string& mediaId) const;
+    UsersInfo getLikes(const std::string& mediaId, UserFields fields = {}) const;
     BaseResult like(const std::string& mediaId);
     BaseResult unlike(const std::string& mediaId);
 //Tags
     TagInfo getTagInfo(const std::string& tagName) const;
     TagsInfo searchTags(const std::string& query) const;
-    MediaEntries getRecentMediaForTag(const std::string& tagName) const;
+    MediaEntries getRecentMediaForTag(const std::string& tagName, MediaFields fields = {}) const;
+    MediaEntryViews getRecentMediaForTagViews(const std::string& tagName, MediaFields fields = {}) const;
+    ArenaMediaEntries getRecentMediaForTagInArena(const std::string& tagName, MediaFields fields = {}) const;
 //Locations
     LocationInfo getLocationById(const std::string& locationId) const;
-    MediaEntries getMediaForLocation(const std::string& locationId) const;
+    MediaEntries getMediaForLocation(const std::string& locationId, MediaFields fields = {}) const;
     LocationsInfo searchLocations(double lat, double lng, int distance = 500) const;
+//Pagination
+    // Every element of every page, see PageRange.
+    PageRange<MediaEntries> recentMediaPages(const std::string& userId, unsigned count = 20, MediaFields fields = {}) const;
+    PageRange<UsersInfo> followsPages(UserFields fields = {}) const;
+    PageRange<UsersInfo> followedByPages(UserFields fields = {}) const;
+    PageRange<MediaEntries> recentMediaForTagPages(const std::string& tagName, MediaFields fields = {}) const;
 private:
-    mutable Http::HttpClient m_httpClient;
+    std::shared_ptr<Http::HttpClient> m_httpClient;
     std::string m_authToken;
+    std::shared_ptr<RateLimitScheduler> m_scheduler{};
+    size_t m_pageArenaSize{PAGE_ARENA_SIZE};
+
+    // identical lookups issued concurrently share one request
+    mutable SingleFlight<UserInfo> m_userInfoCalls{};
+    mutable SingleFlight<MediaEntry> m_mediaCalls{};
+    mutable SingleFlight<TagInfo> m_tagInfoCalls{};
+    mutable SingleFlight<LocationInfo> m_locationCalls{};
+
+    UsersInfo getUsersInfo(const Http::HttpUrl& url, UserFields fields) const;
+    MediaEntries getMedia(const Http::HttpUrl& url, MediaFields fields) const;
+    MediaEntryViews getMediaViews(const Http::HttpUrl& url, MediaFields fields) const;
+    ArenaMediaEntries getMediaInArena(const Http::HttpUrl& url, MediaFields fields) const;
 
-    UsersInfo getUsersInfo(const Http::HttpUrl& url) const;
-    MediaEntries getMedia(const Http::HttpUrl& url) const;
+    PageArena pageArena() const;
 
     enum class Relationship{follow, unfollow, approve, ignore};
     RelationshipInfo postRelationship(Relationship relationship, const std::string& userId);
@@ -0,0 +1,55 @@
+#ifndef INSTAGRAM_CLIENT_POOL_H
+#define INSTAGRAM_CLIENT_POOL_H
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "InstagramClient.h"
+#include "RateLimitScheduler.h"
+
+namespace Instagram{
+
+// One InstagramClient per access token, all on the same HttpClient so they
+// share its connections, cache and limits. Every call goes to the token with
+// the most rate limit budget left, ties are broken round robin.
+class EXPORT_INSTAGRAM InstagramClientPool{
+public:
+    InstagramClientPool(const std::vector<std::string>& authTokens);
+    InstagramClientPool(const InstagramClientPool&) = delete;
+    InstagramClientPool& operator=(const InstagramClientPool&) = delete;
+
+    // The client of the token picked for the next call.
+    InstagramClient& client();
+    InstagramClient& client(const std::string& authToken);
+
+    size_t size() const noexcept;
+
+    // Like the HttpClient setters these are not synchronized, they belong
+    // before the pool is used from more than one thread.
+    void setHedgePolicy(const Http::HedgePolicy& hedgePolicy);
+    void setMetrics(std::shared_ptr<Http::MetricsRegistry> metrics);
+    void setCache(std::shared_ptr<Http::HttpCache> cache);
+    void setConcurrencyLimiter(std::shared_ptr<Http::ConcurrencyLimiter> limiter);
+
+    const std::shared_ptr<RateLimitScheduler>& rateLimitScheduler() const noexcept;
+
+    // Each id is looked up with the token picked for it, on up to `concurrency`
+    // threads. Results keep the order of the ids, the first exception thrown
+    // for any id is rethrown once every thread has stopped.
+    UsersInfo getUsersInfo(const std::vector<std::string>& userIds, size_t concurrency = 8, UserFields fields = {});
+    MediaEntries getMedia(const std::vector<std::string>& mediaIds, size_t concurrency = 8, MediaFields fields = {});
+private:
+    template<typename Result, typename Function>
+    std::vector<Result> forEach(const std::vector<std::string>& ids, size_t concurrency, Function function);
+
+    std::shared_ptr<Http::HttpClient> m_httpClient;
+    std::shared_ptr<RateLimitScheduler> m_scheduler;
+    std::vector<InstagramClient> m_clients{};
+    std::atomic<size_t> m_next{0};
+};
+
+}
+
+#endif
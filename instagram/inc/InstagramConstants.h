@@ -3,29 +3,29 @@
 
 namespace Instagram{
 
-static const char* INSTAGRAM_HOST = "api.instagram.com";
-static const char* AUTH_CODE_GRANT_TYPE = "authorization_code";
-static const char* AUTH_TOKEN_ARG = "access_token";
-static const char* SELF = "self";
-static const char* QUERY_ARG = "q";
-static const char* LAT_ARG = "lat";
-static const char* LNG_ARG = "lng";
-static const char* DST_ARG = "distance";
-static const char* COUNT_ARG = "count";
-static const char* MIN_ID_ARG = "MIN_ID";
-static const char* MAX_ID_ARG = "MAX_ID";
-static const char* MAX_LIKE_ID = "max_like_id";
+inline constexpr const char* INSTAGRAM_HOST = "api.instagram.com";
+inline constexpr const char* AUTH_CODE_GRANT_TYPE = "authorization_code";
+inline constexpr const char* AUTH_TOKEN_ARG = "access_token";
+inline constexpr const char* SELF = "self";
+inline constexpr const char* QUERY_ARG = "q";
+inline constexpr const char* LAT_ARG = "lat";
+inline constexpr const char* LNG_ARG = "lng";
+inline constexpr const char* DST_ARG = "distance";
+inline constexpr const char* COUNT_ARG = "count";
+inline constexpr const char* MIN_ID_ARG = "MIN_ID";
+inline constexpr const char* MAX_ID_ARG = "MAX_ID";
+inline constexpr const char* MAX_LIKE_ID = "max_like_id";
 
-static const char* RELATIONSHIP_ACTION_ARG = "action";
-static const char* RELATIONSHIP_FOLLOW = "follow";
-static const char* RELATIONSHIP_UNFOLLOW = "unfollow";
-static const char* RELATIONSHIP_APPROVE = "approve";
-static const char* RELATIONSHIP_IGNORE = "ignore";
+inline constexpr const char* RELATIONSHIP_ACTION_ARG = "action";
+inline constexpr const char* RELATIONSHIP_FOLLOW = "follow";
+inline constexpr const char* RELATIONSHIP_UNFOLLOW = "unfollow";
+inline constexpr const char* RELATIONSHIP_APPROVE = "approve";
+inline constexpr const char* RELATIONSHIP_IGNORE = "ignore";
 
 enum class Relationship {follow, unfollow, approve, ignore};
 
-static const char* NOT_AUTHENTICATED = "Not authenticated";
-static const char* FORM_DATA_BOUNDARY = "################";
+inline constexpr const char* NOT_AUTHENTICATED = "Not authenticated";
+inline constexpr const char* FORM_DATA_BOUNDARY = "################";
 
 }
 
@@ -1,27 +1,50 @@
 #include <string>
+#include "BodySource.h"
+#include "FieldMask.hpp"
 #include "MediaEntries.h"
+#include "MediaEntryViews.h"
 #include "AuthorizationToken.h"
 #include "UserInfo.h"
 #include "UsersInfo.h"
+#include "UserInfoViews.h"
 #include "RelationshipInfo.h"
 #include "TagInfo.h"
 #include "TagsInfo.h"
 #include "CommentsInfo.h"
 #include "LocationsInfo.h"
+#include "ArenaMediaEntries.h"
+#include "ArenaUsersInfo.h"
+#include "ArenaTagsInfo.h"
+#include "ArenaCommentsInfo.h"
+#include "ArenaLocationsInfo.h"
 
 namespace Instagram{
-    AuthorizationToken parseAuthToken(const std::string& json);
-    MediaEntries parseMediaEntries(const std::string& json);
-    MediaEntry parseMediaEntry(const std::string& json);
-    UserInfo parseUserInfo(const std::string& json);
-    UsersInfo parseUsersInfo(const std::string& json);
-    RelationshipInfo parseRelationshipInfo(const std::string& json);
-    TagInfo parseTagInfo(const std::string& json);
-    TagsInfo parseTagsInfo(const std::string& json);
-    CommentsInfo parseComments(const std::string& json);
-    LocationInfo parseLocation(const std::string& json);
-    LocationsInfo parseLocations(const std::string& json);
+    AuthorizationToken parseAuthToken(std::string json);
+    // Fields left out of the mask keep their defaults. Pages given an arena
+    // are arena pages, allocating their elements from it.
+    MediaEntries parseMediaEntries(std::string json, MediaFields fields = {});
+    ArenaMediaEntries parseMediaEntries(std::string json, MediaFields fields, PageArena arena);
+    MediaEntries parseMediaEntries(Http::BodySource& body, MediaFields fields = {});
+    ArenaMediaEntries parseMediaEntries(Http::BodySource& body, MediaFields fields, PageArena arena);
+    MediaEntry parseMediaEntry(std::string json, MediaFields fields = {});
+    UserInfo parseUserInfo(std::string json, UserFields fields = {});
+    UsersInfo parseUsersInfo(std::string json, UserFields fields = {});
+    ArenaUsersInfo parseUsersInfo(std::string json, UserFields fields, PageArena arena);
+    UsersInfo parseUsersInfo(Http::BodySource& body, UserFields fields = {});
+    ArenaUsersInfo parseUsersInfo(Http::BodySource& body, UserFields fields, PageArena arena);
+    // Views point into json, kept alive by the page and its copies.
+    MediaEntryViews parseMediaEntryViews(std::string json, MediaFields fields = {});
+    UserInfoViews parseUsersInfoViews(std::string json, UserFields fields = {});
+    RelationshipInfo parseRelationshipInfo(std::string json);
+    TagInfo parseTagInfo(std::string json);
+    TagsInfo parseTagsInfo(std::string json);
+    ArenaTagsInfo parseTagsInfo(std::string json, PageArena arena);
+    CommentsInfo parseComments(std::string json);
+    ArenaCommentsInfo parseComments(std::string json, PageArena arena);
+    LocationInfo parseLocation(std::string json);
+    LocationsInfo parseLocations(std::string json);
+    ArenaLocationsInfo parseLocations(std::string json, PageArena arena);
 
-    std::string getError(const std::string& json);
+    std::string getError(std::string json);
 
 }
@@ -0,0 +1,150 @@
+#ifndef INSTAGRAM_PAGE_RANGE_HPP
+#define INSTAGRAM_PAGE_RANGE_HPP
+
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <future>
+#include <iterator>
+#include <string>
+
+namespace Instagram{
+
+// Lazy range over the elements of a paginated endpoint. The first page is
+// requested by begin(), after that every page is followed by its next_url
+// and the page after the current one is already being fetched on another
+// thread while the caller works through the current one. Iteration stops at
+// the last page or at the first page that fails, whose error is then kept in
+// status(). Fetches that throw count as failed pages, iterating never throws.
+// The client the range came from has to outlive it.
+template<typename Page>
+class PageRange
+{
+public:
+    using value_type = typename Page::value_type;
+    using FirstPage = std::function<Page()>;
+    using NextPage = std::function<Page(const std::string& nextUrl)>;
+
+    class iterator
+    {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = typename Page::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = value_type*;
+        using reference = value_type&;
+
+        iterator() {}
+        iterator(PageRange<Page>* range) : m_range{range}{}
+
+        reference operator*() const{
+            return m_range->m_page[m_index];
+        }
+
+        pointer operator->() const{
+            return &m_range->m_page[m_index];
+        }
+
+        iterator& operator++(){
+            if(++m_index >= m_range->m_page.size()){
+                m_index = 0;
+                if(!m_range->advance()){
+                    m_range = nullptr;
+                }
+            }
+            return *this;
+        }
+
+        bool operator==(const iterator& other) const{
+            return m_range == other.m_range && m_index == other.m_index;
+        }
+
+        bool operator!=(const iterator& other) const{
+            return !(*this == other);
+        }
+    private:
+        PageRange<Page>* m_range{nullptr};
+        size_t m_index{0};
+    };
+
+    PageRange(FirstPage firstPage, NextPage nextPage) : m_firstPage{std::move(firstPage)}, m_nextPage{std::move(nextPage)}{}
+    PageRange(const PageRange<Page>&) = delete;
+    PageRange(PageRange<Page>&&) = default;
+
+    PageRange<Page>& operator=(const PageRange<Page>&) = delete;
+    PageRange<Page>& operator=(PageRange<Page>&&) = default;
+
+    // Only one pass is possible, a second begin() continues where the first
+    // iteration stopped.
+    iterator begin(){
+        if(!m_started){
+            m_started = true;
+            m_page = fetch(m_firstPage);
+            prefetch();
+            if(m_page.size() == 0 && !advance()){
+                return end();
+            }
+        }
+        return m_page.size() == 0 ? end() : iterator{this};
+    }
+
+    iterator end(){
+        return iterator{};
+    }
+
+    // The page currently iterated over, or the failed one once iteration
+    // stopped on an error.
+    const Page& status() const noexcept{
+        return m_page;
+    }
+
+    size_t pagesFetched() const noexcept{
+        return m_pagesFetched;
+    }
+private:
+    template<typename Function, typename... Args>
+    static Page fetch(const Function& function, const Args&... args){
+        try{
+            return function(args...);
+        }catch(const std::exception& error){
+            return Page{std::string{error.what()}};
+        }
+    }
+
+    void prefetch(){
+        ++m_pagesFetched;
+        if(m_page.succeed() && m_page.hasNextPage()){
+            m_next = std::async(std::launch::async, [nextPage = m_nextPage, nextUrl = m_page.nextUrl()]() {
+                return fetch(nextPage, nextUrl);
+            });
+        }
+    }
+
+    // Moves on to the next page holding any elements.
+    bool advance(){
+        while(m_next.valid()){
+            m_page = m_next.get();
+            prefetch();
+            if(!m_page.succeed()){
+                return false;
+            }
+            if(m_page.size() > 0){
+                return true;
+            }
+        }
+        m_page.clear();
+        return false;
+    }
+
+    FirstPage m_firstPage;
+    NextPage m_nextPage;
+
+    Page m_page{};
+    std::future<Page> m_next{};
+    bool m_started{false};
+    size_t m_pagesFetched{0};
+};
+
+}
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef INSTAGRAM_RATE_LIMIT_SCHEDULER_H
+#define INSTAGRAM_RATE_LIMIT_SCHEDULER_H
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "RequestThrottle.h"
+#include "RequestTimings.h"
+
+#include "InstagramDefinitions.h"
+
+namespace Instagram{
+
+// Keeps track of the X-Ratelimit-Limit/X-Ratelimit-Remaining budget of every
+// access token and spreads the requests of a token evenly over what is left of
+// its window. Requests beyond the budget wait for the next window instead of
+// being answered with 429. The API does not say when its hourly window resets,
+// it is taken to start with the first request seen for the token.
+class EXPORT_INSTAGRAM RateLimitScheduler : public Http::RequestThrottle, public Http::RequestObserver{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Budget{
+        long limit{-1};
+        long remaining{-1};
+    };
+
+    RateLimitScheduler(std::chrono::seconds window = std::chrono::hours{1});
+
+    void wait(const Http::HttpRequest& request) override;
+    // Only while the token has budget left that is not already scheduled.
+    bool tryPass(const Http::HttpRequest& request) override;
+    void onResponse(const Http::HttpRequest& request, const Http::HttpResponse& response, const Http::RequestTimings& timings) override;
+
+    // -1 for whatever the API has not reported yet.
+    Budget budget(const std::string& authToken) const;
+
+    // What is left once the requests already scheduled are taken off, tokens
+    // the API has not reported on yet count as having the most.
+    long available(const std::string& authToken) const;
+private:
+    struct TokenState{
+        Budget budget{};
+        long reserved{0};
+        Clock::time_point windowEnd{};
+        Clock::time_point nextSlot{};
+        Clock::time_point blockedUntil{};
+    };
+
+    Clock::time_point reserve(const std::string& authToken);
+    void startWindow(TokenState& state, Clock::time_point now) const;
+
+    static std::string authToken(const Http::HttpRequest& request);
+
+    const Clock::duration m_window;
+
+    mutable std::mutex m_mutex{};
+    std::unordered_map<std::string, TokenState> m_tokens{};
+};
+
+}
+
+#endif
@@ -0,0 +1,302 @@
+#ifndef INSTAGRAM_RESULT_SCHEMA_HPP
+#define INSTAGRAM_RESULT_SCHEMA_HPP
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "ArenaCommentInfo.h"
+#include "ArenaLocationInfo.h"
+#include "ArenaMediaEntry.h"
+#include "ArenaTagInfo.h"
+#include "ArenaUserInfo.h"
+#include "ArenaUserTable.h"
+#include "CommentInfo.h"
+#include "FieldMask.hpp"
+#include "LocationInfo.h"
+#include "MediaEntry.h"
+#include "MediaEntryView.h"
+#include "RelationshipInfo.h"
+#include "ResultCollection.hpp"
+#include "TagInfo.h"
+#include "UserInfo.h"
+#include "UserInfoView.h"
+#include "UserTable.h"
+
+namespace Instagram{
+
+// Describes where in a json object the value of one setter of Result comes
+// from. The path names nested members like "images/thumbnail/url". The value
+// is read as Json, a string, int, double, another result with a schema or a
+// user handle interned by the page's user table, and run through convert on
+// its way to the setter unless convert is nullptr.
+// Repeated fields hand every element of an array to the setter. Parsers given
+// a field mask only read the fields whose mask bits it contains.
+template<typename Result, typename Arg, typename Json, typename Convert = std::nullptr_t>
+struct Field{
+    using result_type = Result;
+    using json_type = Json;
+
+    const char* path;
+    void (Result::*setter)(Arg);
+    Convert convert;
+    bool repeated;
+    uint64_t mask;
+
+    void set(Result& result, Json&& value) const{
+        if constexpr (std::is_null_pointer<Convert>::value){
+            (result.*setter)(std::move(value));
+        }else{
+            (result.*setter)(convert(value));
+        }
+    }
+
+    // the part of the path naming the member of the result's own object
+    std::string_view key() const noexcept{
+        const char* end = std::strchr(path, '/');
+        return end ? std::string_view{path, static_cast<size_t>(end - path)} : std::string_view{path};
+    }
+};
+
+// Overloaded setters need Arg given explicitly, field<UserHandle>(...). String
+// setters taking a std::string_view are handed the json's own characters.
+template<typename Arg, typename Result>
+constexpr auto field(const char* path, void (Result::*setter)(Arg), uint64_t mask = ALL_FIELDS){
+    return Field<Result, Arg, std::decay_t<Arg>>{path, setter, nullptr, false, mask};
+}
+
+template<typename Arg, typename Result, typename Json, typename Converted>
+constexpr auto field(const char* path, void (Result::*setter)(Arg), Converted (*convert)(Json), uint64_t mask = ALL_FIELDS){
+    return Field<Result, Arg, Json, Converted (*)(Json)>{path, setter, convert, false, mask};
+}
+
+template<typename Arg, typename Result>
+constexpr auto elements(const char* path, void (Result::*adder)(Arg), uint64_t mask = ALL_FIELDS){
+    return Field<Result, Arg, std::decay_t<Arg>>{path, adder, nullptr, true, mask};
+}
+
+template<typename Field>
+constexpr uint64_t bit(Field field){
+    return static_cast<uint64_t>(field);
+}
+
+// A default value, results taking an allocator are created with it so nested
+// ones end up in the same arena as the result they belong to.
+template<typename Value>
+Value makeValue(const ResultAllocator& allocator){
+    if constexpr (std::uses_allocator<Value, ResultAllocator>::value){
+        return Value{allocator};
+    }else{
+        return Value{};
+    }
+}
+
+// Arena results share the allocator of the page they are read for through
+// the page's table, the others use a UserTable.
+template<typename Result>
+using UserTableOf = std::conditional_t<std::uses_allocator<Result, ResultAllocator>::value, ArenaUserTable, UserTable>;
+
+template<typename Result>
+UserTableOf<Result> makeUserTable(const PageArena& arena){
+    if constexpr (std::uses_allocator<Result, ResultAllocator>::value){
+        return ArenaUserTable{arena};
+    }else{
+        return UserTable{};
+    }
+}
+
+template<typename Page>
+Page makePage(PageArena arena){
+    if constexpr (std::uses_allocator<typename Page::value_type, ResultAllocator>::value){
+        return Page{std::move(arena)};
+    }else{
+        return Page{};
+    }
+}
+
+template<typename Result>
+ResultAllocator allocatorOf(const Result& result){
+    if constexpr (std::uses_allocator<Result, ResultAllocator>::value){
+        return result.get_allocator();
+    }else{
+        return ResultAllocator{};
+    }
+}
+
+template<typename T>
+ResultAllocator allocatorOf(const ResultCollection<T>& page){
+    if constexpr (std::uses_allocator<T, ResultAllocator>::value){
+        return page.get_allocator();
+    }else{
+        return ResultAllocator{};
+    }
+}
+
+// Specialized for every result read from json, fields being a tuple of Field.
+template<typename Result>
+struct Schema;
+
+template<typename Result, typename = void>
+struct HasSchema : std::false_type {};
+
+template<typename Result>
+struct HasSchema<Result, std::void_t<decltype(Schema<Result>::fields)>> : std::true_type {};
+
+// Calls function with every field of Result's schema, unrolled at compile time.
+template<typename Result, typename Function>
+void forEachField(Function&& function){
+    std::apply([&function](const auto&... fields){
+        (function(fields), ...);
+    }, Schema<Result>::fields);
+}
+
+// The mask bits of the field path belongs to, nested paths like "user/bio"
+// count as part of the field named by their first segment.
+template<typename Result>
+uint64_t maskOf(std::string_view path){
+    const std::string_view key = path.substr(0, path.find('/'));
+
+    uint64_t mask = 0;
+    forEachField<Result>([&mask, key](const auto& field){
+        if(field.key() == key){
+            mask |= field.mask;
+        }
+    });
+    return mask;
+}
+
+inline long toTime(std::string_view time){
+    const std::string digits{time};
+    char* end = nullptr;
+    const long result = std::strtol(digits.c_str(), &end, 10);
+    return end != digits.c_str() ? result : -1;
+}
+
+inline MediaType toMediaType(std::string_view type){
+    if(type == "image"){
+        return MediaType::IMAGE;
+    }else if(type == "video"){
+        return MediaType::VIDEO;
+    }
+    return MediaType::UNKNOWN;
+}
+
+// Results are read the same way into the owning results, their arena
+// versions and the views. String is how their string setters take a string,
+// UserArg how setUserInfo takes the user.
+template<typename User, typename String>
+struct UserSchema{
+    static constexpr auto fields = std::make_tuple(
+        field<String>("id", &User::setId, bit(UserField::ID)),
+        field<String>("username", &User::setUsername, bit(UserField::USERNAME)),
+        field<String>("profile_picture", &User::setProfilePictureUrl, bit(UserField::PROFILE_PICTURE)),
+        field<String>("full_name", &User::setFullName, bit(UserField::FULL_NAME)),
+        field<String>("bio", &User::setBio, bit(UserField::BIO)),
+        field<String>("website", &User::setWebsite, bit(UserField::WEBSITE)),
+        field<int>("counts/followed_by", &User::setFollowedBy, bit(UserField::COUNTS)),
+        field<int>("counts/follows", &User::setFollows, bit(UserField::COUNTS)),
+        field<int>("counts/media", &User::setMediaCount, bit(UserField::COUNTS))
+    );
+};
+
+template<typename Media, typename String, typename UserArg>
+struct MediaSchema{
+    static constexpr auto fields = std::make_tuple(
+        field<String>("id", &Media::setId, bit(MediaField::ID)),
+        field<MediaType>("type", &Media::setType, &toMediaType, bit(MediaField::TYPE)),
+        field<String>("link", &Media::setLink, bit(MediaField::LINK)),
+        field<String>("filter", &Media::setFilter, bit(MediaField::FILTER)),
+        field<long>("created_time", &Media::setCreateTime, &toTime, bit(MediaField::CREATE_TIME)),
+        field<String>("caption/text", &Media::setCaption, bit(MediaField::CAPTION)),
+        field<String>("images/low_resolution/url", &Media::setLowResolution, bit(MediaField::IMAGES)),
+        field<String>("images/thumbnail/url", &Media::setThumbnail, bit(MediaField::IMAGES)),
+        field<String>("images/standard_resolution/url", &Media::setStandartResolution, bit(MediaField::IMAGES)),
+        field<String>("videos/low_resolution", &Media::setVideoLowResolution, bit(MediaField::VIDEOS)),
+        field<String>("videos/standart_resolution", &Media::setVideoStandartResolution, bit(MediaField::VIDEOS)),
+        field<int>("comments/count", &Media::setCommentsCount, bit(MediaField::COMMENTS_COUNT)),
+        field<int>("likes/count", &Media::setLikeCount, bit(MediaField::LIKES_COUNT)),
+        elements<String>("tags", &Media::addTag, bit(MediaField::TAGS)),
+        elements<String>("users_in_photo", &Media::addUser, bit(MediaField::USERS_IN_PHOTO)),
+        field<UserArg>("user", &Media::setUserInfo, bit(MediaField::USER))
+    );
+};
+
+template<typename Comment, typename String, typename UserArg>
+struct CommentSchema{
+    static constexpr auto fields = std::make_tuple(
+        field<String>("id", &Comment::setId),
+        field<String>("text", &Comment::setText),
+        field<long>("created_time", &Comment::setCreateTime, &toTime),
+        field<UserArg>("from", &Comment::setUserInfo)
+    );
+};
+
+template<typename Location, typename String>
+struct LocationSchema{
+    static constexpr auto fields = std::make_tuple(
+        field<String>("id", &Location::setId),
+        field<String>("name", &Location::setName),
+        field<double>("latitude", &Location::setLatitude),
+        field<double>("longitude", &Location::setLongitude)
+    );
+};
+
+template<typename Tag, typename String>
+struct TagSchema{
+    static constexpr auto fields = std::make_tuple(
+        field<String>("name", &Tag::setName),
+        field<int>("media_count", &Tag::setCount)
+    );
+};
+
+template<>
+struct Schema<UserInfo> : UserSchema<UserInfo, std::string&&> {};
+
+template<>
+struct Schema<ArenaUserInfo> : UserSchema<ArenaUserInfo, std::string_view> {};
+
+template<>
+struct Schema<UserInfoView> : UserSchema<UserInfoView, std::string_view> {};
+
+template<>
+struct Schema<MediaEntry> : MediaSchema<MediaEntry, std::string&&, UserHandle> {};
+
+template<>
+struct Schema<ArenaMediaEntry> : MediaSchema<ArenaMediaEntry, std::string_view, ArenaUserHandle> {};
+
+template<>
+struct Schema<MediaEntryView> : MediaSchema<MediaEntryView, std::string_view, const UserInfoView&> {};
+
+template<>
+struct Schema<CommentInfo> : CommentSchema<CommentInfo, std::string&&, UserHandle> {};
+
+template<>
+struct Schema<ArenaCommentInfo> : CommentSchema<ArenaCommentInfo, std::string_view, ArenaUserHandle> {};
+
+template<>
+struct Schema<LocationInfo> : LocationSchema<LocationInfo, std::string&&> {};
+
+template<>
+struct Schema<ArenaLocationInfo> : LocationSchema<ArenaLocationInfo, std::string_view> {};
+
+template<>
+struct Schema<TagInfo> : TagSchema<TagInfo, std::string&&> {};
+
+template<>
+struct Schema<ArenaTagInfo> : TagSchema<ArenaTagInfo, std::string_view> {};
+
+template<>
+struct Schema<RelationshipInfo>{
+    static constexpr auto fields = std::make_tuple(
+        field<std::string&&>("incoming_status", &RelationshipInfo::setIncomingStatus),
+        field<std::string&&>("outgoing_status", &RelationshipInfo::setOutgoingStatus)
+    );
+};
+
+}
+
+#endif
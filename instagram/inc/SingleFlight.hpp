@@ -0,0 +1,59 @@
+#ifndef INSTAGRAM_SINGLE_FLIGHT_HPP
+#define INSTAGRAM_SINGLE_FLIGHT_HPP
+
+#include <exception>
+#include <future>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace Instagram{
+
+// Collapses concurrent calls sharing a key into one: the first caller runs the
+// function, everybody arriving while it is in flight waits for and gets a copy
+// of the same result. Nothing is remembered once the call completes.
+template<typename Result>
+class SingleFlight
+{
+public:
+    SingleFlight() {}
+    SingleFlight(const SingleFlight<Result>&) = delete;
+    SingleFlight<Result>& operator=(const SingleFlight<Result>&) = delete;
+
+    template<typename Function>
+    Result run(const std::string& key, Function&& function){
+        std::unique_lock<std::mutex> lock{m_mutex};
+
+        auto it = m_calls.find(key);
+        if(it != m_calls.end()){
+            std::shared_future<Result> call = it->second;
+            lock.unlock();
+            return call.get();
+        }
+
+        std::promise<Result> promise{};
+        std::shared_future<Result> call = promise.get_future().share();
+        m_calls.emplace(key, call);
+        lock.unlock();
+
+        try{
+            promise.set_value(function());
+        }catch(...){
+            promise.set_exception(std::current_exception());
+        }
+
+        lock.lock();
+        m_calls.erase(key);
+        lock.unlock();
+
+        return call.get();
+    }
+
+private:
+    std::mutex m_mutex{};
+    std::unordered_map<std::string, std::shared_future<Result>> m_calls{};
+};
+
+}
+
+#endif
@@ -13,21 +13,71 @@ inline Http::HttpUrl getUrl(const std::string &str){
     return {INSTAGRAM_HOST, str, Http::HttpProtocol::HTTPS};
 }
 
-InstagramClient::InstagramClient() :  m_httpClient {}, m_authToken { "" } {}
+// lookups of one url asking for different fields must not share a call
+template<typename Field>
+std::string callKey(const Http::HttpUrl& url, FieldMask<Field> fields){
+    return fields == FieldMask<Field>{} ? url.url() : url.url() + '#' + std::to_string(fields.bits());
+}
+
+InstagramClient::InstagramClient() :  m_httpClient {std::make_shared<Http::HttpClient>()}, m_authToken { "" } {}
 
 InstagramClient::InstagramClient(InstagramClient&& client) : InstagramClient{} {
     swap(*this, client);
 }
 
-InstagramClient::InstagramClient(const std::string& authToken) : m_httpClient{}, m_authToken{authToken}{}
+InstagramClient::InstagramClient(const std::string& authToken) : m_httpClient{std::make_shared<Http::HttpClient>()}, m_authToken{authToken}{}
+
+InstagramClient::InstagramClient(const std::string& authToken, std::shared_ptr<Http::HttpClient> httpClient) :
+    m_httpClient{std::move(httpClient)}, m_authToken{authToken}{}
 
 InstagramClient& InstagramClient::operator=(InstagramClient&& client){
     m_httpClient = std::move(client.m_httpClient);
     m_authToken = std::move(client.m_authToken);
+    m_scheduler = std::move(client.m_scheduler);
+    m_pageArenaSize = client.m_pageArenaSize;
 
     return *this;
 }
 
+void InstagramClient::setHedgePolicy(const Http::HedgePolicy& hedgePolicy) {
+    m_httpClient->setHedgePolicy(hedgePolicy);
+}
+
+void InstagramClient::setMetrics(std::shared_ptr<Http::MetricsRegistry> metrics) {
+    m_httpClient->setMetrics(std::move(metrics));
+}
+
+const std::shared_ptr<Http::MetricsRegistry>& InstagramClient::metrics() const noexcept {
+    return m_httpClient->metrics();
+}
+
+void InstagramClient::setCache(std::shared_ptr<Http::HttpCache> cache) {
+    m_httpClient->setCache(std::move(cache));
+}
+
+void InstagramClient::setConcurrencyLimiter(std::shared_ptr<Http::ConcurrencyLimiter> limiter) {
+    m_httpClient->setConcurrencyLimiter(std::move(limiter));
+}
+
+void InstagramClient::setRateLimitScheduler(std::shared_ptr<RateLimitScheduler> scheduler) {
+    m_httpClient->removeObserver(m_scheduler);
+    m_scheduler = std::move(scheduler);
+    m_httpClient->setThrottle(m_scheduler);
+    m_httpClient->addObserver(m_scheduler);
+}
+
+const std::shared_ptr<RateLimitScheduler>& InstagramClient::rateLimitScheduler() const noexcept {
+    return m_scheduler;
+}
+
+void InstagramClient::setPageArenaSize(size_t initialSize) {
+    m_pageArenaSize = initialSize;
+}
+
+PageArena InstagramClient::pageArena() const {
+    return makePageArena(m_pageArenaSize > 0 ? m_pageArenaSize : PAGE_ARENA_SIZE);
+}
+
 const std::string& InstagramClient::getAuthToken() const {
     return m_authToken;
 }
@@ -43,7 +93,7 @@ inline bool InstagramClient::checkAuth() const {
 std::string InstagramClient::getResult(const Http::HttpResponse& response) const {
     switch (response.code()) {
     case Http::Status::BAD_REQUEST:
-        return getError(response.body());
+        return getError(std::string{response.bodyView()});
     default:
         return response.getString();
     }
@@ -61,9 +111,9 @@ AuthorizationToken InstagramClient::authenticate(const std::string& code,
     form_data["redirect_uri"] = redirectUri;
     form_data["grant_type"] = AUTH_CODE_GRANT_TYPE;
 
-    const Http::HttpResponse response = m_httpClient.post(getUrl(Auth::GET_AUTH_CODE), form_data);
+    Http::HttpResponse response = m_httpClient->post(getUrl(Auth::GET_AUTH_CODE), form_data);
     if (response.code() == Http::Status::OK) {
-        AuthorizationToken authToken = parseAuthToken(response.body());
+        AuthorizationToken authToken = parseAuthToken(response.takeBody());
         setAuthToken(authToken.token());
 
         return authToken;
@@ -72,11 +122,11 @@ AuthorizationToken InstagramClient::authenticate(const std::string& code,
     }
 }
 
-UserInfo InstagramClient::getUserInfo() const {
-    return getUserInfo(SELF);
+UserInfo InstagramClient::getUserInfo(UserFields fields) const {
+    return getUserInfo(SELF, fields);
 }
 
-UserInfo InstagramClient::getUserInfo(const std::string& userId) const {
+UserInfo InstagramClient::getUserInfo(const std::string& userId, UserFields fields) const {
     if(!checkAuth()){
         return NOT_AUTHENTICATED;
     }
@@ -84,19 +134,44 @@ UserInfo InstagramClient::getUserInfo(const std::string& userId) const {
     Http::HttpUrl url = getUrl(Users::users + userId);
     url[AUTH_TOKEN_ARG] = m_authToken;
 
-    const Http::HttpResponse response = m_httpClient << url;
-    if (response.code() == Http::Status::OK) {
-        return parseUserInfo(response.body());
-    } else {
-        return getResult(response);
+    return m_userInfoCalls.run(callKey(url, fields), [this, &url, fields]() -> UserInfo {
+        Http::HttpResponse response = m_httpClient->hedgedGet(url);
+        if (response.code() == Http::Status::OK) {
+            return parseUserInfo(response.takeBody(), fields);
+        } else {
+            return getResult(response);
+        }
+    });
+}
+
+UsersInfo InstagramClient::getUsersInfo(const std::vector<std::string>& userIds, UserFields fields) const {
+    if(!checkAuth()){
+        return NOT_AUTHENTICATED;
+    }
+
+    std::vector<Http::HttpUrl> urls{};
+    urls.reserve(userIds.size());
+    for (const std::string& userId : userIds) {
+        urls.push_back(getUrl(Users::users + userId));
+        urls.back()[AUTH_TOKEN_ARG] = m_authToken;
+    }
+
+    UsersInfo result{};
+    for (Http::HttpResponse& response : m_httpClient->getBatch(urls)) {
+        if (response.code() == Http::Status::OK) {
+            result << parseUserInfo(response.takeBody(), fields);
+        } else {
+            result << UserInfo{getResult(response)};
+        }
     }
+    return result;
 }
 
-MediaEntries InstagramClient::getRecentMedia(unsigned count) const {
-    return getRecentMedia(SELF, count);
+MediaEntries InstagramClient::getRecentMedia(unsigned count, MediaFields fields) const {
+    return getRecentMedia(SELF, count, fields);
 }
 
-MediaEntries InstagramClient::getRecentMedia(const std::string& userId, unsigned count) const {
+MediaEntries InstagramClient::getRecentMedia(const std::string& userId, unsigned count, MediaFields fields) const {
     if(!checkAuth()){ 
         return NOT_AUTHENTICATED;
     }
@@ -105,14 +180,38 @@ MediaEntries InstagramClient::getRecentMedia(const std::string& userId, unsigned
     url[AUTH_TOKEN_ARG] = m_authToken;
     url[COUNT_ARG] = std::to_string(count);
 
-    return getMedia(url);
+    return getMedia(url, fields);
 } 
 
-MediaEntries InstagramClient::getRecentMedia(const std::string& min_id, const std::string& max_id, unsigned count) const {
-    return getRecentMedia(SELF, min_id, max_id, count);
+MediaEntryViews InstagramClient::getRecentMediaViews(const std::string& userId, unsigned count, MediaFields fields) const {
+    if(!checkAuth()){
+        return NOT_AUTHENTICATED;
+    }
+
+    Http::HttpUrl url = getUrl(Users::users + userId + Media::recentMedia);
+    url[AUTH_TOKEN_ARG] = m_authToken;
+    url[COUNT_ARG] = std::to_string(count);
+
+    return getMediaViews(url, fields);
 }
 
-MediaEntries InstagramClient::getRecentMedia(const std::string& userId, const std::string& min_id, const std::string& max_id, unsigned count) const {
+ArenaMediaEntries InstagramClient::getRecentMediaInArena(const std::string& userId, unsigned count, MediaFields fields) const {
+    if(!checkAuth()){
+        return NOT_AUTHENTICATED;
+    }
+
+    Http::HttpUrl url = getUrl(Users::users + userId + Media::recentMedia);
+    url[AUTH_TOKEN_ARG] = m_authToken;
+    url[COUNT_ARG] = std::to_string(count);
+
+    return getMediaInArena(url, fields);
+}
+
+MediaEntries InstagramClient::getRecentMedia(const std::string& min_id, const std::string& max_id, unsigned count, MediaFields fields) const {
+    return getRecentMedia(SELF, min_id, max_id, count, fields);
+}
+
+MediaEntries InstagramClient::getRecentMedia(const std::string& userId, const std::string& min_id, const std::string& max_id, unsigned count, MediaFields fields) const {
     if(!checkAuth()){
         return NOT_AUTHENTICATED;
     }
@@ -125,10 +224,10 @@ MediaEntries InstagramClient::getRecentMedia(const std::string& userId, const st
     
     url[COUNT_ARG] = std::to_string(count);
 
-    return getMedia(url);
+    return getMedia(url, fields);
 }
 
-MediaEntries InstagramClient::getLikedMedia(unsigned int count) const {
+MediaEntries InstagramClient::getLikedMedia(unsigned int count, MediaFields fields) const {
     if(!checkAuth()){
         return NOT_AUTHENTICATED;
     }
@@ -137,10 +236,10 @@ MediaEntries InstagramClient::getLikedMedia(unsigned int count) const {
     url[AUTH_TOKEN_ARG] = m_authToken;
     url[COUNT_ARG] = std::to_string(count);
 
-    return getMedia(url);
+    return getMedia(url, fields);
 }
 
-MediaEntries InstagramClient::getLikedMedia(const std::string& max_id, unsigned int count) const {
+MediaEntries InstagramClient::getLikedMedia(const std::string& max_id, unsigned int count, MediaFields fields) const {
     if(!checkAuth()){
         return NOT_AUTHENTICATED;
     }
@@ -150,20 +249,46 @@ MediaEntries InstagramClient::getLikedMedia(const std::string& max_id, unsigned
     url[MAX_LIKE_ID] = max_id;
     url[COUNT_ARG] = std::to_string(count);
 
-    return getMedia(url);
+    return getMedia(url, fields);
 }
 
-MediaEntries InstagramClient::getMedia(const Http::HttpUrl& url) const {
-    const Http::HttpResponse response = m_httpClient << url;
+MediaEntries InstagramClient::getMedia(const Http::HttpUrl& url, MediaFields fields) const {
+    MediaEntries result{};
+    Http::HttpResponse response = m_httpClient->getStreamed(url, [&result, fields](const Http::HttpResponse&, Http::BodySource& body) {
+        result = parseMediaEntries(body, fields);
+    });
 
     if (response.code() == Http::Status::OK) {
-        return parseMediaEntries(response.body());
+        return result;
     } else {
         return getResult(response);
     }
 }
 
-UsersInfo InstagramClient::searchUsers(const std::string& query, unsigned count) const {
+ArenaMediaEntries InstagramClient::getMediaInArena(const Http::HttpUrl& url, MediaFields fields) const {
+    ArenaMediaEntries result{};
+    Http::HttpResponse response = m_httpClient->getStreamed(url, [this, &result, fields](const Http::HttpResponse&, Http::BodySource& body) {
+        result = parseMediaEntries(body, fields, pageArena());
+    });
+
+    if (response.code() == Http::Status::OK) {
+        return result;
+    } else {
+        return getResult(response);
+    }
+}
+
+// Views need the whole response kept, it is not streamed.
+MediaEntryViews InstagramClient::getMediaViews(const Http::HttpUrl& url, MediaFields fields) const {
+    Http::HttpResponse response = *m_httpClient << url;
+    if (response.code() == Http::Status::OK) {
+        return parseMediaEntryViews(response.takeBody(), fields);
+    } else {
+        return getResult(response);
+    }
+}
+
+UsersInfo InstagramClient::searchUsers(const std::string& query, unsigned count, UserFields fields) const {
     if(!checkAuth()){
         return NOT_AUTHENTICATED;
     }
@@ -173,47 +298,50 @@ UsersInfo InstagramClient::searchUsers(const std::string& query, unsigned count)
     url[QUERY_ARG] = query;
     url[COUNT_ARG] = std::to_string(count);
 
-    return getUsersInfo(url);
+    return getUsersInfo(url, fields);
 }
 
-UsersInfo InstagramClient::getFollows() const {
+UsersInfo InstagramClient::getFollows(UserFields fields) const {
     if(!checkAuth()){
        return NOT_AUTHENTICATED;
     } 
     Http::HttpUrl url = getUrl(std::string{Users::users} + Relationships::follows);
     url[AUTH_TOKEN_ARG] = m_authToken;
-    return getUsersInfo(url);
+    return getUsersInfo(url, fields);
 }
 
-UsersInfo InstagramClient::getFollowedBy() const {
+UsersInfo InstagramClient::getFollowedBy(UserFields fields) const {
     if(!checkAuth()){
        return NOT_AUTHENTICATED;
     } 
 
     Http::HttpUrl url = getUrl(std::string{Users::users} + Relationships::followedBy);
     url[AUTH_TOKEN_ARG] = m_authToken;
-    return getUsersInfo(url);
+    return getUsersInfo(url, fields);
 }
 
-UsersInfo InstagramClient::getRequestedBy() const {
+UsersInfo InstagramClient::getRequestedBy(UserFields fields) const {
     if(!checkAuth()){
        return NOT_AUTHENTICATED;
     }
 
     Http::HttpUrl url = getUrl(std::string{Users::users} + Relationships::requestedBy);
     url[AUTH_TOKEN_ARG] = m_authToken;
-    return getUsersInfo(url);
+    return getUsersInfo(url, fields);
 }
 
-UsersInfo InstagramClient::getUsersInfo(const Http::HttpUrl& url) const {
+UsersInfo InstagramClient::getUsersInfo(const Http::HttpUrl& url, UserFields fields) const {
     if(!checkAuth()){
         return NOT_AUTHENTICATED;
     } 
 
-    const Http::HttpResponse response = m_httpClient << url;
+    UsersInfo result{};
+    Http::HttpResponse response = m_httpClient->getStreamed(url, [&result, fields](const Http::HttpResponse&, Http::BodySource& body) {
+        result = parseUsersInfo(body, fields);
+    });
 
     if (response.code() == Http::Status::OK) {
-        return parseUsersInfo(response.body());
+        return result;
     } else {
         return getResult(response);
     }
@@ -227,10 +355,10 @@ RelationshipInfo InstagramClient::getRelationshipInfo(const std::string& userId)
     Http::HttpUrl url = getUrl(Users::users + userId + Relationships::relationship);
     url[AUTH_TOKEN_ARG] = m_authToken;
 
-    const Http::HttpResponse response = m_httpClient << url;
+    Http::HttpResponse response = *m_httpClient << url;
 
     if (response.code() == Http::Status::OK) {
-        return parseRelationshipInfo(response.body());
+        return parseRelationshipInfo(response.takeBody());
     } else {
         return getResult(response);
     }
@@ -258,6 +386,8 @@ RelationshipInfo InstagramClient::postRelationship(Relationship relationship, co
     }
 
     Http::HttpUrl url = getUrl(Users::users + userId + Relationships::relationship);
+    url[AUTH_TOKEN_ARG] = m_authToken;
+
     Http::FormData formData{FORM_DATA_BOUNDARY};
 
     switch(relationship){
@@ -276,15 +406,15 @@ RelationshipInfo InstagramClient::postRelationship(Relationship relationship, co
     }
     formData[AUTH_TOKEN_ARG] = m_authToken;
 
-    const Http::HttpResponse response = m_httpClient.post(url, formData);
+    Http::HttpResponse response = m_httpClient->post(url, formData);
     if(response.code() == Http::Status::OK){
-        return parseRelationshipInfo(response.body());
+        return parseRelationshipInfo(response.takeBody());
     }else{
         return getResult(response);
     }
 }
 
-MediaEntry InstagramClient::getMedia(const std::string& mediaId) const {
+MediaEntry InstagramClient::getMedia(const std::string& mediaId, MediaFields fields) const {
     if(!checkAuth()){ 
         return NOT_AUTHENTICATED;
     }
@@ -292,15 +422,40 @@ MediaEntry InstagramClient::getMedia(const std::string& mediaId) const {
     Http::HttpUrl url  = getUrl(Media::media + mediaId);
     url[AUTH_TOKEN_ARG] = m_authToken;
 
-    const Http::HttpResponse response = m_httpClient << url;
-    if (response.code() == Http::Status::OK) {
-        return parseMediaEntry(response.body());
-    } else {
-        return getResult(response);
+    return m_mediaCalls.run(callKey(url, fields), [this, &url, fields]() -> MediaEntry {
+        Http::HttpResponse response = m_httpClient->hedgedGet(url);
+        if (response.code() == Http::Status::OK) {
+            return parseMediaEntry(response.takeBody(), fields);
+        } else {
+            return getResult(response);
+        }
+    });
+}
+
+MediaEntries InstagramClient::getMedia(const std::vector<std::string>& mediaIds, MediaFields fields) const {
+    if(!checkAuth()){
+        return NOT_AUTHENTICATED;
+    }
+
+    std::vector<Http::HttpUrl> urls{};
+    urls.reserve(mediaIds.size());
+    for (const std::string& mediaId : mediaIds) {
+        urls.push_back(getUrl(Media::media + mediaId));
+        urls.back()[AUTH_TOKEN_ARG] = m_authToken;
+    }
+
+    MediaEntries result{};
+    for (Http::HttpResponse& response : m_httpClient->getBatch(urls)) {
+        if (response.code() == Http::Status::OK) {
+            result << parseMediaEntry(response.takeBody(), fields);
+        } else {
+            result << MediaEntry{getResult(response)};
+        }
     }
+    return result;
 }
 
-MediaEntry InstagramClient::getMediaWithShortCode(const std::string& shortcode) const {
+MediaEntry InstagramClient::getMediaWithShortCode(const std::string& shortcode, MediaFields fields) const {
     if(!checkAuth()){
         return NOT_AUTHENTICATED;
     } 
@@ -308,15 +463,17 @@ MediaEntry InstagramClient::getMediaWithShortCode(const std::string& shortcode)
     Http::HttpUrl url = getUrl(Media::byShortCode + shortcode);
     url[AUTH_TOKEN_ARG] = m_authToken;
 
-    const Http::HttpResponse response = m_httpClient << url;
-    if (response.code() == Http::Status::OK) {
-        return parseMediaEntry(response.body());
-    } else {
-        return getResult(response);
-    }
+    return m_mediaCalls.run(callKey(url, fields), [this, &url, fields]() -> MediaEntry {
+        Http::HttpResponse response = *m_httpClient << url;
+        if (response.code() == Http::Status::OK) {
+            return parseMediaEntry(response.takeBody(), fields);
+        } else {
+            return getResult(response);
+        }
+    });
 }
 
-MediaEntries InstagramClient::searchMedia(double lat, double lng, int distance) const {
+MediaEntries InstagramClient::searchMedia(double lat, double lng, int distance, MediaFields fields) const {
     if(!checkAuth()){
         return NOT_AUTHENTICATED;
     }
@@ -329,7 +486,7 @@ MediaEntries InstagramClient::searchMedia(double lat, double lng, int distance)
     url[DST_ARG] = std::to_string(distance);
     url[AUTH_TOKEN_ARG] = m_authToken;
 
-    return getMedia(url);
+    return getMedia(url, fields);
 }
 
 CommentsInfo InstagramClient::getComments(const std::string& mediaId) const {
@@ -340,9 +497,9 @@ CommentsInfo InstagramClient::getComments(const std::string& mediaId) const {
     Http::HttpUrl url = getUrl(Media::media + mediaId + Comments::comments);
     url[AUTH_TOKEN_ARG] = m_authToken;
 
-    const Http::HttpResponse response = m_httpClient << url;
+    Http::HttpResponse response = *m_httpClient << url;
     if (response.code() == Http::Status::OK) {
-        return parseComments(response.body());
+        return parseComments(response.takeBody());
     } else {
         return getResult(response);
     }
@@ -359,7 +516,7 @@ BaseResult InstagramClient::comment(const std::string& mediaId, const std::strin
     Http::FormData form_data {FORM_DATA_BOUNDARY};
     form_data[Comments::TEXT_ARG] = text;
 
-    const Http::HttpResponse response = m_httpClient.post(url, form_data);
+    const Http::HttpResponse response = m_httpClient->post(url, form_data);
     if (response.code() == Http::Status::OK) {
         return {};
     } else {
@@ -374,7 +531,7 @@ BaseResult InstagramClient::deleteComment(const std::string& mediaId, const std:
 
     Http::HttpUrl url = getUrl(Media::media + mediaId + Comments::comments + commentId);
     url[AUTH_TOKEN_ARG] = m_authToken;
-    const Http::HttpResponse response = m_httpClient.del(url);
+    const Http::HttpResponse response = m_httpClient->del(url);
     if (response.code() == Http::Status::OK) {
         return {};
     } else {
@@ -382,7 +539,7 @@ BaseResult InstagramClient::deleteComment(const std::string& mediaId, const std:
     }
 }
 
-UsersInfo InstagramClient::getLikes(const std::string& mediaId) const {
+UsersInfo InstagramClient::getLikes(const std::string& mediaId, UserFields fields) const {
     if(!checkAuth()){
         return NOT_AUTHENTICATED;
     }
@@ -390,7 +547,7 @@ UsersInfo InstagramClient::getLikes(const std::string& mediaId) const {
     Http::HttpUrl url = getUrl(Media::media + mediaId + Likes::likes);
     url[AUTH_TOKEN_ARG] = m_authToken;
 
-    return getUsersInfo(url);
+    return getUsersInfo(url, fields);
 }
 
 BaseResult InstagramClient::like(const std::string& mediaId) {
@@ -399,10 +556,12 @@ BaseResult InstagramClient::like(const std::string& mediaId) {
     }
 
     Http::HttpUrl url = getUrl(Media::media + mediaId + Likes::likes);
+    url[AUTH_TOKEN_ARG] = m_authToken;
+
     Http::FormData form_data {FORM_DATA_BOUNDARY};
     form_data[AUTH_TOKEN_ARG] = m_authToken;
 
-    const Http::HttpResponse response = m_httpClient.post(url, form_data);
+    const Http::HttpResponse response = m_httpClient->post(url, form_data);
     if (response.code() == Http::Status::OK) {
         return {};
     } else {
@@ -418,7 +577,7 @@ BaseResult InstagramClient::unlike(const std::string& mediaId) {
     Http::HttpUrl url = getUrl(Media::media + mediaId + Likes::likes);
     url[AUTH_TOKEN_ARG] = m_authToken;
 
-    const Http::HttpResponse response = m_httpClient.del(url);
+    const Http::HttpResponse response = m_httpClient->del(url);
     if (response.code() == Http::Status::OK) {
         return {};
     } else {
@@ -434,12 +593,14 @@ TagInfo InstagramClient::getTagInfo(const std::string& tag_name) const {
     Http::HttpUrl url = getUrl(Tags::tags + tag_name);
     url[AUTH_TOKEN_ARG] = m_authToken;
 
-    const Http::HttpResponse response = m_httpClient << url;
-    if (response.code() == Http::Status::OK) {
-        return parseTagInfo(response.body());
-    } else {
-        return getResult(response);
-    }
+    return m_tagInfoCalls.run(url.url(), [this, &url]() -> TagInfo {
+        Http::HttpResponse response = *m_httpClient << url;
+        if (response.code() == Http::Status::OK) {
+            return parseTagInfo(response.takeBody());
+        } else {
+            return getResult(response);
+        }
+    });
 }
 
 TagsInfo InstagramClient::searchTags(const std::string& query) const {
@@ -451,16 +612,16 @@ TagsInfo InstagramClient::searchTags(const std::string& query) const {
     url[QUERY_ARG] = query;
     url[AUTH_TOKEN_ARG] = m_authToken;
 
-    const Http::HttpResponse response = m_httpClient << url;
+    Http::HttpResponse response = *m_httpClient << url;
     if (response.code() == Http::Status::OK) {
-        return parseTagsInfo(response.body());
+        return parseTagsInfo(response.takeBody());
     } else {
         return getResult(response);
     }
 
 }
 
-MediaEntries InstagramClient::getRecentMediaForTag(const std::string& tag_name) const {
+MediaEntries InstagramClient::getRecentMediaForTag(const std::string& tag_name, MediaFields fields) const {
     if(!checkAuth()){
         return NOT_AUTHENTICATED;
     }
@@ -468,12 +629,29 @@ MediaEntries InstagramClient::getRecentMediaForTag(const std::string& tag_name)
     Http::HttpUrl url = getUrl(Tags::tags + tag_name + Media::recentMedia);
     url[AUTH_TOKEN_ARG] = m_authToken;
 
-    const Http::HttpResponse response = m_httpClient << url;
-    if (response.code() == Http::Status::OK) {
-        return parseMediaEntries(response.body());
-    } else {
-        return getResult(response);
+    return getMedia(url, fields);
+}
+
+MediaEntryViews InstagramClient::getRecentMediaForTagViews(const std::string& tag_name, MediaFields fields) const {
+    if(!checkAuth()){
+        return NOT_AUTHENTICATED;
+    }
+
+    Http::HttpUrl url = getUrl(Tags::tags + tag_name + Media::recentMedia);
+    url[AUTH_TOKEN_ARG] = m_authToken;
+
+    return getMediaViews(url, fields);
+}
+
+ArenaMediaEntries InstagramClient::getRecentMediaForTagInArena(const std::string& tag_name, MediaFields fields) const {
+    if(!checkAuth()){
+        return NOT_AUTHENTICATED;
     }
+
+    Http::HttpUrl url = getUrl(Tags::tags + tag_name + Media::recentMedia);
+    url[AUTH_TOKEN_ARG] = m_authToken;
+
+    return getMediaInArena(url, fields);
 }
 
 LocationInfo InstagramClient::getLocationById(const std::string& location_id) const {
@@ -484,27 +662,25 @@ LocationInfo InstagramClient::getLocationById(const std::string& location_id) co
     Http::HttpUrl url = getUrl(Locations::locations + location_id);
     url[AUTH_TOKEN_ARG] = m_authToken;
 
-    const Http::HttpResponse response = m_httpClient << url;
-    if (response.code() == Http::Status::OK) {
-        return parseLocation(response.body());
-    } else {
-        return getResult(response);
-    }
+    return m_locationCalls.run(url.url(), [this, &url]() -> LocationInfo {
+        Http::HttpResponse response = *m_httpClient << url;
+        if (response.code() == Http::Status::OK) {
+            return parseLocation(response.takeBody());
+        } else {
+            return getResult(response);
+        }
+    });
 }
 
-MediaEntries InstagramClient::getMediaForLocation(const std::string& location_id) const {
+MediaEntries InstagramClient::getMediaForLocation(const std::string& location_id, MediaFields fields) const {
     if(!checkAuth()){
         return NOT_AUTHENTICATED;
     }
 
     Http::HttpUrl url = getUrl(Locations::locations + location_id + Media::recentMedia);
-    Http::HttpResponse response = m_httpClient << url;
+    url[AUTH_TOKEN_ARG] = m_authToken;
 
-    if (response.code() == Http::Status::OK) {
-        return parseMediaEntries(response.body());
-    } else {
-        return getResult(response);
-    }
+    return getMedia(url, fields);
 }
 
 LocationsInfo InstagramClient::searchLocations(double lat, double lng, int distance) const {
@@ -518,18 +694,40 @@ LocationsInfo InstagramClient::searchLocations(double lat, double lng, int dista
     url[DST_ARG] = std::to_string(distance);
     url[AUTH_TOKEN_ARG] = m_authToken;
 
-    Http::HttpResponse response = m_httpClient << url;
+    Http::HttpResponse response = *m_httpClient << url;
     if (response.code() == Http::Status::OK) {
-        return parseLocations(response.body());
+        return parseLocations(response.takeBody());
     } else {
         return getResult(response);
     }
 }
 
+PageRange<MediaEntries> InstagramClient::recentMediaPages(const std::string& userId, unsigned count, MediaFields fields) const {
+    return {[this, userId, count, fields]() { return getRecentMedia(userId, count, fields); },
+            [this, fields](const std::string& nextUrl) { return getMedia(Http::HttpUrl{nextUrl}, fields); }};
+}
+
+PageRange<UsersInfo> InstagramClient::followsPages(UserFields fields) const {
+    return {[this, fields]() { return getFollows(fields); },
+            [this, fields](const std::string& nextUrl) { return getUsersInfo(Http::HttpUrl{nextUrl}, fields); }};
+}
+
+PageRange<UsersInfo> InstagramClient::followedByPages(UserFields fields) const {
+    return {[this, fields]() { return getFollowedBy(fields); },
+            [this, fields](const std::string& nextUrl) { return getUsersInfo(Http::HttpUrl{nextUrl}, fields); }};
+}
+
+PageRange<MediaEntries> InstagramClient::recentMediaForTagPages(const std::string& tagName, MediaFields fields) const {
+    return {[this, tagName, fields]() { return getRecentMediaForTag(tagName, fields); },
+            [this, fields](const std::string& nextUrl) { return getMedia(Http::HttpUrl{nextUrl}, fields); }};
+}
+
 void swap(InstagramClient& first, InstagramClient& second){
     using std::swap;
     swap(first.m_httpClient, second.m_httpClient);
     swap(first.m_authToken, second.m_authToken);
+    swap(first.m_scheduler, second.m_scheduler);
+    swap(first.m_pageArenaSize, second.m_pageArenaSize);
 }
 
 }
@@ -0,0 +1,108 @@
+#include <stdexcept>
+
+#include "InstagramClientPool.h"
+#include "FanOut.h"
+
+namespace Instagram {
+
+InstagramClientPool::InstagramClientPool(const std::vector<std::string>& authTokens) :
+    m_httpClient{std::make_shared<Http::HttpClient>()},
+    m_scheduler{std::make_shared<RateLimitScheduler>()} {
+
+    if (authTokens.empty()) {
+        throw std::invalid_argument("client pool needs at least one access token");
+    }
+
+    // installed once on the shared HttpClient instead of through every client
+    m_httpClient->setThrottle(m_scheduler);
+    m_httpClient->addObserver(m_scheduler);
+
+    m_clients.reserve(authTokens.size());
+    for (const std::string& authToken : authTokens) {
+        m_clients.emplace_back(authToken, m_httpClient);
+    }
+}
+
+InstagramClient& InstagramClientPool::client() {
+    const size_t start = m_next++;
+
+    size_t best = start % m_clients.size();
+    long bestAvailable = -1;
+
+    for (size_t i = 0; i < m_clients.size(); ++i) {
+        const size_t index = (start + i) % m_clients.size();
+        const long available = m_scheduler->available(m_clients[index].getAuthToken());
+        if (available > bestAvailable) {
+            best = index;
+            bestAvailable = available;
+        }
+    }
+
+    return m_clients[best];
+}
+
+InstagramClient& InstagramClientPool::client(const std::string& authToken) {
+    for (InstagramClient& instagramClient : m_clients) {
+        if (instagramClient.getAuthToken() == authToken) {
+            return instagramClient;
+        }
+    }
+    throw std::out_of_range("no client for the access token");
+}
+
+size_t InstagramClientPool::size() const noexcept {
+    return m_clients.size();
+}
+
+void InstagramClientPool::setHedgePolicy(const Http::HedgePolicy& hedgePolicy) {
+    m_httpClient->setHedgePolicy(hedgePolicy);
+}
+
+void InstagramClientPool::setMetrics(std::shared_ptr<Http::MetricsRegistry> metrics) {
+    m_httpClient->setMetrics(std::move(metrics));
+}
+
+void InstagramClientPool::setCache(std::shared_ptr<Http::HttpCache> cache) {
+    m_httpClient->setCache(std::move(cache));
+}
+
+void InstagramClientPool::setConcurrencyLimiter(std::shared_ptr<Http::ConcurrencyLimiter> limiter) {
+    m_httpClient->setConcurrencyLimiter(std::move(limiter));
+}
+
+const std::shared_ptr<RateLimitScheduler>& InstagramClientPool::rateLimitScheduler() const noexcept {
+    return m_scheduler;
+}
+
+UsersInfo InstagramClientPool::getUsersInfo(const std::vector<std::string>& userIds, size_t concurrency, UserFields fields) {
+    UsersInfo result{};
+    for (UserInfo& userInfo : forEach<UserInfo>(userIds, concurrency, [this, fields](const std::string& userId) {
+        return client().getUserInfo(userId, fields);
+    })) {
+        result << std::move(userInfo);
+    }
+    return result;
+}
+
+MediaEntries InstagramClientPool::getMedia(const std::vector<std::string>& mediaIds, size_t concurrency, MediaFields fields) {
+    MediaEntries result{};
+    for (MediaEntry& mediaEntry : forEach<MediaEntry>(mediaIds, concurrency, [this, fields](const std::string& mediaId) {
+        return client().getMedia(mediaId, fields);
+    })) {
+        result << std::move(mediaEntry);
+    }
+    return result;
+}
+
+template<typename Result, typename Function>
+std::vector<Result> InstagramClientPool::forEach(const std::vector<std::string>& ids, size_t concurrency, Function function) {
+    std::vector<Result> results(ids.size());
+
+    Http::fanOut(ids.size(), concurrency, [&](size_t i) {
+        results[i] = function(ids[i]);
+    });
+
+    return results;
+}
+
+}
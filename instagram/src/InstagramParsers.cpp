@@ -1,28 +1,96 @@
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 #include <rapidjson/document.h>
 #include "InstagramParsers.h"
+#include "ResultSchema.hpp"
 
 using namespace rapidjson;
 
 namespace Instagram {
 
+static const size_t PARSER_POOL_MIN_SIZE = 16 * 1024;
+static const size_t PARSER_POOL_MAX_SIZE = 1024 * 1024;
+
+// The first chunk of a thread's DOM pool, grown to the biggest input seen up
+// to the max size. It is left uninitialized, the allocator writes every byte
+// it hands out.
+struct ParserPool{
+    void reserve(size_t size){
+        size = std::min(std::max(size, PARSER_POOL_MIN_SIZE), PARSER_POOL_MAX_SIZE);
+        if(allocator && size <= bufferSize){
+            return;
+        }
+
+        // the allocator keeps its chunk list in the buffer, it goes first
+        allocator.reset();
+        buffer.reset(new char[size]);
+        bufferSize = size;
+        allocator = std::make_unique<MemoryPoolAllocator<>>(buffer.get(), bufferSize);
+    }
+
+    std::unique_ptr<char[]> buffer{};
+    size_t bufferSize{0};
+    std::unique_ptr<MemoryPoolAllocator<>> allocator{};
+    bool inUse{false};
+};
+
+static ParserPool& parserPool(){
+    thread_local ParserPool pool{};
+    return pool;
+}
+
+// Documents are parsed in-situ over the json the parse functions own, string
+// values point into it instead of being copied. The DOM nodes come out of a
+// per thread pool whose first chunk survives between parses, only DOMs bigger
+// than it take more chunks from the heap. The parse stack still comes from
+// rapidjson's CrtAllocator, one small allocation per parse. A document created
+// while another one of the same thread is alive falls back to its own allocator.
+class PooledDocument : public Document{
+public:
+    explicit PooledDocument(size_t inputSize) : Document{acquire(inputSize)}, m_pooled{&GetAllocator() == parserPool().allocator.get()} {}
+    PooledDocument(const PooledDocument&) = delete;
+
+    ~PooledDocument(){
+        if(m_pooled){
+            // values allocated from a memory pool are never freed one by one,
+            // the document does not touch the pool after this
+            parserPool().allocator->Clear();
+            parserPool().inUse = false;
+        }
+    }
+private:
+    static MemoryPoolAllocator<>* acquire(size_t inputSize){
+        ParserPool& pool = parserPool();
+        if(pool.inUse){
+            return nullptr;
+        }
+        pool.reserve(inputSize);
+        pool.inUse = true;
+        return pool.allocator.get();
+    }
+
+    bool m_pooled;
+};
+
+static const Value NULL_VALUE{};
+
 class ValueWrapper{
 public:
     ValueWrapper(const Value& value) : m_ref{value} {}
     ValueWrapper(const ValueWrapper& valueWrapper) = delete;
     ValueWrapper(ValueWrapper&& valueWrapper) : m_ref{std::move(valueWrapper.m_ref)} {}
 
-    inline ValueWrapper operator[](const char* value){
-        return m_ref.HasMember(value) ? ValueWrapper{m_ref[value]} : ValueWrapper{Value{}};
+    inline ValueWrapper operator[](const char* value) const{
+        return ValueWrapper{find(value)};
     }
 
     inline std::string getString(const char* value) const{
-        if(m_ref.HasMember(value)){
-            const Value& tempValue = m_ref[value];
-            if(tempValue.IsString()){
-                return tempValue.GetString();
-            }
-        }
-        return "";
+        return ValueWrapper{find(value)}.getString();
     }
 
     inline std::string getString() const{
@@ -30,14 +98,7 @@ public:
     }
 
     inline int getInt(const char* value) const{
-        if(m_ref.HasMember(value)){
-            const Value& tempValue = m_ref[value];
-            if(tempValue.IsInt()){
-                return tempValue.GetInt();
-            }
-        }
-
-        return -1;
+        return ValueWrapper{find(value)}.getInt();
     }
 
     inline int getInt() const{
@@ -45,13 +106,8 @@ public:
     }
 
     inline double getDouble(const char* value) const{
-        if(m_ref.HasMember(value)){
-            const Value& tempValue = m_ref[value];
-            if(tempValue.IsDouble()){
-                return tempValue.GetDouble();
-            }
-        }
-        return -1.0;
+        const Value& tempValue = find(value);
+        return tempValue.IsDouble() ? tempValue.GetDouble() : -1.0;
     }
 
     inline bool isArray() const{
@@ -66,302 +122,478 @@ public:
         return m_ref.IsNull();
     }
 
-    inline bool hasMember(const char* member){
-        return m_ref.HasMember(member);
+    inline bool hasMember(const char* member) const{
+        return &find(member) != &NULL_VALUE;
     }
 
 private:
+    // one scan over the members, misses yield the shared null value
+    inline const Value& find(const char* member) const{
+        if(!m_ref.IsObject()){
+            return NULL_VALUE;
+        }
+        const Value::ConstMemberIterator it = m_ref.FindMember(member);
+        return it != m_ref.MemberEnd() ? it->value : NULL_VALUE;
+    }
+
     const Value& m_ref;
 };
 
-MediaEntry getMediaEntry(ValueWrapper media);
-UserInfo getUserInfo(ValueWrapper info);
-CommentInfo getCommentInfo(ValueWrapper comment);
-LocationInfo getLocation(ValueWrapper locations);
+template<typename Result>
+using FieldTable = std::unordered_multimap<std::string_view, void(*)(Result&, const Value&, uint64_t, UserTableOf<Result>&)>;
 
-AuthorizationToken parseAuthToken(const std::string& json) {
-    AuthorizationToken token{};
+template<typename Result>
+void bind(Result& result, const Value& object, uint64_t mask, UserTableOf<Result>& users);
 
-    Document document;
-    if (document.Parse(json.c_str()).HasParseError() || !document.HasMember("access_token")) {
-        return "Failed to parse access token";
+static bool read(const Value& value, std::string& result) {
+    if (!value.IsString()) {
+        return false;
     }
+    result.assign(value.GetString(), value.GetStringLength());
+    return true;
+}
 
-    token.setAuthToken(document["access_token"].GetString());
-    token.setUserInfo(getUserInfo(document["user"]));
-    return token;
+// points into the document, the setter copies it before the document goes
+static bool read(const Value& value, std::string_view& result) {
+    if (!value.IsString()) {
+        return false;
+    }
+    result = std::string_view{value.GetString(), value.GetStringLength()};
+    return true;
 }
 
-MediaEntries parseMediaEntries(const std::string& json) {
-    Document document{};
+static bool read(const Value& value, int& result) {
+    if (!value.IsInt()) {
+        return false;
+    }
+    result = value.GetInt();
+    return true;
+}
 
-    if (document.Parse(json.c_str()).HasParseError() || !document.HasMember("data")) {
-        return "Failed to parse media entries";
-    };
+static bool read(const Value& value, double& result) {
+    if (!value.IsNumber()) {
+        return false;
+    }
+    result = value.GetDouble();
+    return true;
+}
 
-    ValueWrapper data{document["data"]};
-    MediaEntries result{};
-    if (data.isArray()) {
-        for (const auto& media : data.getArray()) {
-            result << getMediaEntry(media);
+template<typename Json, typename Users>
+bool read(const Value& value, Json& result, Users& users) {
+    if constexpr (HasSchema<Json>::value) {
+        if (!value.IsObject()) {
+            return false;
         }
+        bind(result, value, ALL_FIELDS, users);
+        return true;
+    } else {
+        return read(value, result);
     }
-    return result;
 }
 
-MediaEntry parseMediaEntry(const std::string& json) {
-    Document document;
-
-    if (document.Parse(json.c_str()).HasParseError() || !document.HasMember("data")) {
-        return "Failed to parse media entry";
+// Read on the heap, the page only gets a copy of users it has not seen yet.
+static bool read(const Value& value, UserHandle& result, UserTable& users) {
+    UserInfo userInfo{};
+    if (!read(value, userInfo, users)) {
+        return false;
     }
+    result = users.intern(std::move(userInfo));
+    return true;
+}
 
-    return getMediaEntry(document["data"]);
+static bool read(const Value& value, ArenaUserHandle& result, ArenaUserTable& users) {
+    ArenaUserInfo userInfo{};
+    if (!read(value, userInfo, users)) {
+        return false;
+    }
+    result = users.intern(std::move(userInfo));
+    return true;
 }
 
-MediaEntry getMediaEntry(ValueWrapper media) {
-    MediaEntry entry{};
+// the value at the end of path, nullptr when some member along it is missing
+static const Value* findPath(const Value& object, const char* path) {
+    const Value* value = &object;
+    while (*path != '\0') {
+        const char* end = std::strchr(path, '/');
+        const size_t length = end ? static_cast<size_t>(end - path) : std::strlen(path);
+        if (!value->IsObject()) {
+            return nullptr;
+        }
 
-    const ValueWrapper tags{media["tags"]};
-    if (tags.isArray()) {
-        for (const auto& tag : tags.getArray()) {
-            entry.addTag(tag.GetString());
+        const Value::ConstMemberIterator it = value->FindMember(Value{StringRef(path, static_cast<SizeType>(length))});
+        if (it == value->MemberEnd()) {
+            return nullptr;
         }
+        value = &it->value;
+        path = end ? end + 1 : path + length;
     }
+    return value;
+}
 
-    const ValueWrapper usersInPhoto{media["users_in_photo"]};
-    if (usersInPhoto.isArray()) {
-        for (const auto& user : usersInPhoto.getArray()) {
-            entry.addUser(user.GetString());
+// Sets field I of Result's schema from member, the value of the first
+// segment of the field's path, unless the mask leaves the field out. Missing
+// values and values of another type leave the default.
+template<typename Result, size_t I>
+void bindField(Result& result, const Value& member, uint64_t mask, UserTableOf<Result>& users) {
+    const auto& field = std::get<I>(Schema<Result>::fields);
+    using Json = typename std::decay_t<decltype(field)>::json_type;
+
+    if ((field.mask & mask) == 0) {
+        return;
+    }
+
+    const char* nested = std::strchr(field.path, '/');
+    const Value* value = nested ? findPath(member, nested + 1) : &member;
+    if (!value) {
+        return;
+    }
+
+    if (!field.repeated) {
+        Json json = makeValue<Json>(allocatorOf(result));
+        if (read(*value, json, users)) {
+            field.set(result, std::move(json));
+        }
+    } else if (value->IsArray()) {
+        for (const Value& element : value->GetArray()) {
+            Json json = makeValue<Json>(allocatorOf(result));
+            if (read(element, json, users)) {
+                field.set(result, std::move(json));
+            }
         }
     }
+}
+
+template<typename Result, size_t... I>
+FieldTable<Result> makeFieldTable(std::index_sequence<I...>) {
+    return FieldTable<Result>{{std::get<I>(Schema<Result>::fields).key(), &bindField<Result, I>}...};
+}
+
+// Walks the members of object once, every member is looked up in a table
+// generated from the schema and handed to the fields starting with it.
+template<typename Result>
+void bind(Result& result, const Value& object, uint64_t mask, UserTableOf<Result>& users) {
+    using Fields = std::remove_const_t<decltype(Schema<Result>::fields)>;
+    static const FieldTable<Result> table = makeFieldTable<Result>(std::make_index_sequence<std::tuple_size<Fields>::value>{});
+
+    if (!object.IsObject()) {
+        return;
+    }
 
-    const ValueWrapper type{media["type"]};
-    if (!type.isNull()) {
-        const std::string type_str = type.getString();
-        if (type_str == "image") {
-            entry.setType(MediaType::IMAGE);
-        } else if(type_str == "video") {
-            entry.setType(MediaType::VIDEO);
-            ValueWrapper videos{media["videos"]};
-            entry.setVideoLowResolution(videos.getString("low_resolution"));
-            entry.setVideoStandartResolution(videos.getString("standart_resolution"));
+    for (const auto& member : object.GetObject()) {
+        const auto fields = table.equal_range(std::string_view{member.name.GetString(), member.name.GetStringLength()});
+        for (auto it = fields.first; it != fields.second; ++it) {
+            it->second(result, member.value, mask, users);
         }
     }
+}
 
-    const ValueWrapper create_time{media["created_time"]};
-    long created_time = create_time.isNull() ? -1 : std::stol(create_time.getString());
-    entry.setCreateTime(created_time);
+// Results of a page are created with the allocator of the page's users.
+template<typename Result>
+Result bind(const Value& object, uint64_t mask, UserTableOf<Result>& users) {
+    Result result = makeValue<Result>(allocatorOf(users));
+    bind(result, object, mask, users);
+    return result;
+}
 
-    const ValueWrapper link{media["link"]};
-    entry.setLink(link.getString());
+template<typename Result>
+Result bind(const Value& object, uint64_t mask = ALL_FIELDS) {
+    UserTableOf<Result> users = makeUserTable<Result>(nullptr);
+    return bind<Result>(object, mask, users);
+}
 
-    const ValueWrapper caption{media["caption"]};
-    entry.setCaption(caption.getString("text"));
+// follows, followed-by and tag feeds each name their cursor differently
+template<typename T>
+void getPagination(const Document& document, ResultCollection<T>& collection) {
+    if (!document.HasMember("pagination")) {
+        return;
+    }
 
-    {
-        ValueWrapper images{media["images"]};
+    ValueWrapper pagination{document["pagination"]};
+    collection.setNextUrl(pagination.getString("next_url"));
 
-        ValueWrapper low_resolution = images["low_resolution"];
-        entry.setLowResolution(low_resolution.getString("url"));
+    for (const char* cursor : {"next_max_id", "next_max_tag_id", "next_cursor"}) {
+        std::string nextMaxId = pagination.getString(cursor);
+        if (!nextMaxId.empty()) {
+            collection.setNextMaxId(std::move(nextMaxId));
+            break;
+        }
+    }
+}
 
-        ValueWrapper thumbnail{images["thumbnail"]};
-        entry.setThumbnail(thumbnail.getString("url"));
+AuthorizationToken parseAuthToken(std::string json) {
+    AuthorizationToken token{};
 
-        ValueWrapper standart_resolution{images["standard_resolution"]};
-        entry.setStandartResolution(standart_resolution.getString("url"));
+    PooledDocument document{json.size()};
+    if (document.ParseInsitu(&json[0]).HasParseError() || !document.HasMember("access_token")) {
+        return "Failed to parse access token";
     }
 
-    const ValueWrapper comments{media["comments"]};
-    entry.setCommentsCount(comments.getInt("count"));
+    token.setAuthToken(document["access_token"].GetString());
+    token.setUserInfo(bind<UserInfo>(document["user"]));
+    return token;
+}
 
-    const ValueWrapper likes = media["likes"];
-    entry.setLikeCount(likes.getInt("count"));
+template<typename Page>
+Page parseMediaPage(std::string json, MediaFields fields, PageArena arena) {
+    using Media = typename Page::value_type;
+    PooledDocument document{json.size()};
 
-    entry.setFilter(media.getString("filter"));
-    entry.setId(media.getString("id"));
+    if (document.ParseInsitu(&json[0]).HasParseError() || !document.HasMember("data")) {
+        return "Failed to parse media entries";
+    };
 
-    entry.setUserInfo(getUserInfo(media["user"]));
+    ValueWrapper data{document["data"]};
+    Page result = makePage<Page>(std::move(arena));
+    UserTableOf<Media> users = makeUserTable<Media>(result.arena());
+    if (data.isArray()) {
+        for (const auto& media : data.getArray()) {
+            result << bind<Media>(media, fields.bits(), users);
+        }
+    }
+    getPagination(document, result);
+    return result;
+}
+
+MediaEntries parseMediaEntries(std::string json, MediaFields fields) {
+    return parseMediaPage<MediaEntries>(std::move(json), fields, nullptr);
+}
 
-    return entry;
+ArenaMediaEntries parseMediaEntries(std::string json, MediaFields fields, PageArena arena) {
+    return parseMediaPage<ArenaMediaEntries>(std::move(json), fields, std::move(arena));
 }
 
-UserInfo parseUserInfo(const std::string& json) {
-    Document document{};
+MediaEntry parseMediaEntry(std::string json, MediaFields fields) {
+    PooledDocument document{json.size()};
 
-    if (document.Parse(json.c_str()).HasParseError() || !document.HasMember("data")) {
+    if (document.ParseInsitu(&json[0]).HasParseError() || !document.HasMember("data")) {
+        return "Failed to parse media entry";
+    }
+
+    return bind<MediaEntry>(document["data"], fields.bits());
+}
+
+UserInfo parseUserInfo(std::string json, UserFields fields) {
+    PooledDocument document{json.size()};
+
+    if (document.ParseInsitu(&json[0]).HasParseError() || !document.HasMember("data")) {
         return "Failed to parse user info";
     }
 
-    return getUserInfo(document["data"]);
+    return bind<UserInfo>(document["data"], fields.bits());
 }
 
-UsersInfo parseUsersInfo(const std::string& json) {
-    Document document{};
+template<typename Page>
+Page parseUsersPage(std::string json, UserFields fields, PageArena arena) {
+    using User = typename Page::value_type;
+    PooledDocument document{json.size()};
 
-    if (document.Parse(json.c_str()).HasParseError() || !document.HasMember("data")) {
+    if (document.ParseInsitu(&json[0]).HasParseError() || !document.HasMember("data")) {
         return "Failed to parse users info";
     }
 
     ValueWrapper data{document["data"]};
-    UsersInfo users_info{};
+    Page users_info = makePage<Page>(std::move(arena));
+    UserTableOf<User> users = makeUserTable<User>(users_info.arena());
     if(data.isArray()){
         for (const Value& userInfo : data.getArray()) {
-            users_info << getUserInfo(userInfo);
+            users_info << bind<User>(userInfo, fields.bits(), users);
         }
     }
+    getPagination(document, users_info);
     return users_info;
 }
 
-UserInfo getUserInfo(ValueWrapper info) {
-    UserInfo userInfo{};
+UsersInfo parseUsersInfo(std::string json, UserFields fields) {
+    return parseUsersPage<UsersInfo>(std::move(json), fields, nullptr);
+}
 
-    userInfo.setId(info.getString("id"));
-    userInfo.setUsername(info.getString("username"));
-    userInfo.setProfilePictureUrl(info.getString("profile_picture"));
+ArenaUsersInfo parseUsersInfo(std::string json, UserFields fields, PageArena arena) {
+    return parseUsersPage<ArenaUsersInfo>(std::move(json), fields, std::move(arena));
+}
 
-    userInfo.setFullName(info.getString("full_name"));
-    userInfo.setBio(info.getString("bio"));
-    userInfo.setWebsite(info.getString("website"));
+// The page keeps the json parsed in-situ, the strings of its views point into it.
+MediaEntryViews parseMediaEntryViews(std::string json, MediaFields fields) {
+    auto source = std::make_shared<std::string>(std::move(json));
+    PooledDocument document{source->size()};
 
-    if (info.hasMember("counts")) {
-        ValueWrapper counts{info["counts"]};
-        userInfo.setFollowedBy(counts.getInt("followed_by"));
-        userInfo.setFollows(counts.getInt("follows"));
-        userInfo.setMediaCount(counts.getInt("media"));
+    if (document.ParseInsitu(&(*source)[0]).HasParseError() || !document.HasMember("data")) {
+        return "Failed to parse media entries";
     }
 
-    return userInfo;
+    ValueWrapper data{document["data"]};
+    MediaEntryViews result{source};
+    if (data.isArray()) {
+        for (const auto& media : data.getArray()) {
+            result << bind<MediaEntryView>(media, fields.bits());
+        }
+    }
+    getPagination(document, result);
+    return result;
 }
 
-RelationshipInfo parseRelationshipInfo(const std::string& json) {
-    Document document{};
+UserInfoViews parseUsersInfoViews(std::string json, UserFields fields) {
+    auto source = std::make_shared<std::string>(std::move(json));
+    PooledDocument document{source->size()};
 
-    if (document.Parse(json.c_str()).HasParseError() || !document.HasMember("data")) {
-        return "Failed to parse relationship info";
+    if (document.ParseInsitu(&(*source)[0]).HasParseError() || !document.HasMember("data")) {
+        return "Failed to parse users info";
     }
 
     ValueWrapper data{document["data"]};
-    RelationshipInfo rel_info{ data.getString("incoming_status"), data.getString("outgoing_status") };
+    UserInfoViews users_info{source};
+    if (data.isArray()) {
+        for (const Value& userInfo : data.getArray()) {
+            users_info << bind<UserInfoView>(userInfo, fields.bits());
+        }
+    }
+    getPagination(document, users_info);
+    return users_info;
+}
+
+RelationshipInfo parseRelationshipInfo(std::string json) {
+    PooledDocument document{json.size()};
 
-    return rel_info;
+    if (document.ParseInsitu(&json[0]).HasParseError() || !document.HasMember("data")) {
+        return "Failed to parse relationship info";
+    }
+
+    return bind<RelationshipInfo>(document["data"]);
 }
 
-TagInfo parseTagInfo(const std::string& json) {
-    Document document{};
+TagInfo parseTagInfo(std::string json) {
+    PooledDocument document{json.size()};
 
-    if (document.Parse(json.c_str()).HasParseError() || !document.HasMember("data")) {
+    if (document.ParseInsitu(&json[0]).HasParseError() || !document.HasMember("data")) {
         return "Failed to parse tag info";
     }
 
-    ValueWrapper data{document["data"]};
-    TagInfo tag_info(data.getString("name"), data.getInt("media_count"));
-
-    return tag_info;
+    return bind<TagInfo>(document["data"]);
 }
 
-TagsInfo parseTagsInfo(const std::string& json) {
-    Document document{};
+template<typename Page>
+Page parseTagsPage(std::string json, PageArena arena) {
+    using Tag = typename Page::value_type;
+    PooledDocument document{json.size()};
 
-    if (document.Parse(json.c_str()).HasParseError() || !document.HasMember("data")) {
+    if (document.ParseInsitu(&json[0]).HasParseError() || !document.HasMember("data")) {
         return "Failed to parse tags info";
     }
 
-    TagsInfo tags_info;
+    Page tags_info = makePage<Page>(std::move(arena));
+    UserTableOf<Tag> users = makeUserTable<Tag>(tags_info.arena());
     ValueWrapper data{document["data"]};
     if (data.isArray()) {
         for (const auto& tag : data.getArray()) {
-            tags_info << TagInfo{ tag["name"].GetString(), tag["media_count"].GetInt() };
+            tags_info << bind<Tag>(tag, ALL_FIELDS, users);
         }
     }
 
     return tags_info;
 }
 
-CommentsInfo parseComments(const std::string& json) {
-    Document document{};
+TagsInfo parseTagsInfo(std::string json) {
+    return parseTagsPage<TagsInfo>(std::move(json), nullptr);
+}
+
+ArenaTagsInfo parseTagsInfo(std::string json, PageArena arena) {
+    return parseTagsPage<ArenaTagsInfo>(std::move(json), std::move(arena));
+}
+
+template<typename Comment>
+Comment getCommentInfo(const Value& comment, UserTableOf<Comment>& users) {
+    if(comment.IsNull()){
+        return "Invalid json document, failed to parse comment";
+    }
 
-    if (document.Parse(json.c_str()).HasParseError() || !document.HasMember("data")) {
+    return bind<Comment>(comment, ALL_FIELDS, users);
+}
+
+template<typename Page>
+Page parseCommentsPage(std::string json, PageArena arena) {
+    using Comment = typename Page::value_type;
+    PooledDocument document{json.size()};
+
+    if (document.ParseInsitu(&json[0]).HasParseError() || !document.HasMember("data")) {
         return "Failed to parse comments";
     }
 
-    CommentsInfo commentsInfo{};
+    Page commentsInfo = makePage<Page>(std::move(arena));
+    UserTableOf<Comment> users = makeUserTable<Comment>(commentsInfo.arena());
     ValueWrapper data{document["data"]};
     if (data.isArray()) {
         for (const Value& comment : data.getArray()) {
-            commentsInfo << getCommentInfo(comment);
+            commentsInfo << getCommentInfo<Comment>(comment, users);
         }
     }
 
     return commentsInfo;
 }
 
-CommentInfo getCommentInfo(ValueWrapper comment) {
-    if(comment.isNull()){
-        return "Invalid json document, failed to parse comment";
-    }
-
-    CommentInfo commentInfo{};
-
-    commentInfo.setText(comment.getString("text"));
-    commentInfo.setId(comment.getString("id"));
-    commentInfo.setCreateTime(std::stol(comment.getString("created_time")));
-
-    commentInfo.setUserInfo(getUserInfo(comment["from"]));
-
-    return commentInfo;
+CommentsInfo parseComments(std::string json) {
+    return parseCommentsPage<CommentsInfo>(std::move(json), nullptr);
 }
 
-LocationInfo parseLocation(const std::string& json) {
-    Document document{};
+ArenaCommentsInfo parseComments(std::string json, PageArena arena) {
+    return parseCommentsPage<ArenaCommentsInfo>(std::move(json), std::move(arena));
+}
 
-    if (document.Parse(json.c_str()).HasParseError() || !document.HasMember("data")) {
-        return "Failed to parse location";
+template<typename Location>
+Location getLocation(const Value& location, UserTableOf<Location>& users) {
+    if (!location.IsNull()) {
+        return bind<Location>(location, ALL_FIELDS, users);
+    } else {
+        return "Invalid json, failed to parse location";
     }
-
-    return getLocation(document["data"]);
 }
 
-LocationInfo getLocation(ValueWrapper location) {
-    if (!location.isNull()) {
-        LocationInfo info{};
-        info.setId(location.getString("id"));
-        info.setName(location.getString("name"));
-        info.setLatitude(location.getDouble("latitude"));
-        info.setLongitude(location.getDouble("longitude"));
+LocationInfo parseLocation(std::string json) {
+    PooledDocument document{json.size()};
 
-        return info;
-    } else {
-        return "Invalid json, failed to parse location";
+    if (document.ParseInsitu(&json[0]).HasParseError() || !document.HasMember("data")) {
+        return "Failed to parse location";
     }
+
+    UserTable users{};
+    return getLocation<LocationInfo>(document["data"], users);
 }
 
-LocationsInfo parseLocations(const std::string& json) {
-    Document document{};
+template<typename Page>
+Page parseLocationsPage(std::string json, PageArena arena) {
+    using Location = typename Page::value_type;
+    PooledDocument document{json.size()};
 
-    if (document.Parse(json.c_str()).HasParseError() || !document.HasMember("data")) {
+    if (document.ParseInsitu(&json[0]).HasParseError() || !document.HasMember("data")) {
         return "Failed to parse locations";
     }
 
-    LocationsInfo infos{};
+    Page infos = makePage<Page>(std::move(arena));
+    UserTableOf<Location> users = makeUserTable<Location>(infos.arena());
     ValueWrapper data{document["data"]};
     if (data.isArray()) {
         for (const auto& location : data.getArray()) {
-            infos << getLocation(location);
+            infos << getLocation<Location>(location, users);
         }
     }
 
     return infos;
 }
 
-std::string getError(const std::string& json) {
-    Document document{};
+LocationsInfo parseLocations(std::string json) {
+    return parseLocationsPage<LocationsInfo>(std::move(json), nullptr);
+}
+
+ArenaLocationsInfo parseLocations(std::string json, PageArena arena) {
+    return parseLocationsPage<ArenaLocationsInfo>(std::move(json), std::move(arena));
+}
+
+std::string getError(std::string json) {
+    PooledDocument document{json.size()};
 
-    if (document.Parse(json.c_str()).HasParseError()) {
+    if (document.ParseInsitu(&json[0]).HasParseError()) {
         return "Failed to parse error";
     }
 
-    ValueWrapper meta{document.HasMember("meta") ? document : document["meta"]};
+    ValueWrapper meta{document.HasMember("meta") ? document["meta"] : document};
 
     int code = meta.getInt("code");
     if (code == 200) {
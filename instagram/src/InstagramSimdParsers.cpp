@@ -0,0 +1,642 @@
+#include <cstdlib>
+#include <limits>
+#include <memory>
+#include <string>
+#include <simdjson.h>
+#include "InstagramParsers.h"
+#include "ResultSchema.hpp"
+
+using namespace simdjson;
+
+namespace Instagram {
+
+static ondemand::parser& parser() {
+    thread_local ondemand::parser parser{};
+    return parser;
+}
+
+// The parse functions own their json, so the padding the parser reads past
+// the end is reserved on it instead of copying into a padded_string.
+static ondemand::document iterate(ondemand::parser& parser, std::string& json) {
+    json.reserve(json.size() + SIMDJSON_PADDING);
+    return parser.iterate(json.data(), json.size(), json.capacity());
+}
+
+static ondemand::document iterate(std::string& json) {
+    return iterate(parser(), json);
+}
+
+// Strings are unescaped into the buffer of the parser that read them, pages
+// of views keep the json along with a parser of their own.
+struct ViewSource {
+    explicit ViewSource(std::string json) : json{std::move(json)} {}
+
+    std::string json;
+    ondemand::parser parser{};
+};
+
+// Values of an unexpected type read like missing ones, as with rapidjson.
+static std::string getString(ondemand::value value) {
+    std::string_view str{};
+    return value.get_string().get(str) == SUCCESS ? std::string{str} : std::string{};
+}
+
+static int getInt(ondemand::value value) {
+    int64_t number{};
+    if (value.get_int64().get(number) != SUCCESS ||
+        number < std::numeric_limits<int>::min() || number > std::numeric_limits<int>::max()) {
+        return -1;
+    }
+    return static_cast<int>(number);
+}
+
+static bool isNull(ondemand::value value) {
+    return value.is_null();
+}
+
+// On demand values have to be consumed in document order, so every object is
+// walked once and its fields dispatched by key.
+template<typename Function>
+static void forEachMember(ondemand::value value, Function&& function) {
+    ondemand::object object{};
+    if (value.get_object().get(object) != SUCCESS) {
+        return;
+    }
+    for (ondemand::field field : object) {
+        function(field.unescaped_key().value(), field.value());
+    }
+}
+
+template<typename Function>
+static void forEachElement(ondemand::value value, Function&& function) {
+    ondemand::array array{};
+    if (value.get_array().get(array) != SUCCESS) {
+        return;
+    }
+    for (ondemand::value element : array) {
+        function(element);
+    }
+}
+
+// Calls function with the data member of the document and returns whether
+// there was one, the pagination object is handed to pagination.
+template<typename Function, typename Pagination>
+static bool forData(ondemand::document& document, Function&& function, Pagination&& pagination) {
+    bool hasData = false;
+    for (ondemand::field field : document.get_object()) {
+        const std::string_view key = field.unescaped_key().value();
+        if (key == "data") {
+            hasData = true;
+            function(field.value());
+        } else if (key == "pagination") {
+            pagination(field.value());
+        }
+    }
+    return hasData;
+}
+
+template<typename Function>
+static bool forData(ondemand::document& document, Function&& function) {
+    return forData(document, std::forward<Function>(function), [](ondemand::value) {});
+}
+
+template<typename Result>
+void bind(Result& result, ondemand::value object, uint64_t mask, UserTableOf<Result>& users);
+
+static bool read(ondemand::value value, std::string& result) {
+    std::string_view str{};
+    if (value.get_string().get(str) != SUCCESS) {
+        return false;
+    }
+    result.assign(str.data(), str.size());
+    return true;
+}
+
+// points into the parser's string buffer, owning results copy it right away
+static bool read(ondemand::value value, std::string_view& result) {
+    return value.get_string().get(result) == SUCCESS;
+}
+
+static bool read(ondemand::value value, int& result) {
+    int64_t number{};
+    if (value.get_int64().get(number) != SUCCESS ||
+        number < std::numeric_limits<int>::min() || number > std::numeric_limits<int>::max()) {
+        return false;
+    }
+    result = static_cast<int>(number);
+    return true;
+}
+
+static bool read(ondemand::value value, double& result) {
+    return value.get_double().get(result) == SUCCESS;
+}
+
+template<typename Json, typename Users>
+bool read(ondemand::value value, Json& result, Users& users) {
+    if constexpr (HasSchema<Json>::value) {
+        if (value.type() != ondemand::json_type::object) {
+            return false;
+        }
+        bind(result, value, ALL_FIELDS, users);
+        return true;
+    } else {
+        return read(value, result);
+    }
+}
+
+// Read on the heap, the page only gets a copy of users it has not seen yet.
+static bool read(ondemand::value value, UserHandle& result, UserTable& users) {
+    UserInfo userInfo{};
+    if (!read(value, userInfo, users)) {
+        return false;
+    }
+    result = users.intern(std::move(userInfo));
+    return true;
+}
+
+static bool read(ondemand::value value, ArenaUserHandle& result, ArenaUserTable& users) {
+    ArenaUserInfo userInfo{};
+    if (!read(value, userInfo, users)) {
+        return false;
+    }
+    result = users.intern(std::move(userInfo));
+    return true;
+}
+
+template<typename Field, typename Result>
+void setField(const Field& field, Result& result, ondemand::value value, UserTableOf<Result>& users) {
+    using Json = typename Field::json_type;
+
+    if (!field.repeated) {
+        Json json = makeValue<Json>(allocatorOf(result));
+        if (read(value, json, users)) {
+            field.set(result, std::move(json));
+        }
+    } else {
+        forEachElement(value, [&field, &result, &users](ondemand::value element) {
+            Json json = makeValue<Json>(allocatorOf(result));
+            if (read(element, json, users)) {
+                field.set(result, std::move(json));
+            }
+        });
+    }
+}
+
+// Members are visited once in document order: a member either is the value of
+// a field or, when some field's path continues below it, is walked in turn.
+// Members of no field in the mask are never touched, which skips them.
+template<typename Result>
+void bindMembers(ondemand::value object, Result& result, std::string& path, uint64_t mask, UserTableOf<Result>& users) {
+    forEachMember(object, [&result, &path, mask, &users](std::string_view key, ondemand::value value) {
+        const size_t parentLength = path.size();
+        if (!path.empty()) {
+            path += '/';
+        }
+        path += key;
+
+        bool nested = false;
+        forEachField<Result>([&](const auto& field) {
+            const std::string_view fieldPath{field.path};
+            if ((field.mask & mask) == 0) {
+                return;
+            } else if (fieldPath == path) {
+                setField(field, result, value, users);
+            } else if (fieldPath.size() > path.size() && fieldPath[path.size()] == '/' && fieldPath.compare(0, path.size(), path) == 0) {
+                nested = true;
+            }
+        });
+        if (nested) {
+            bindMembers(value, result, path, mask, users);
+        }
+
+        path.resize(parentLength);
+    });
+}
+
+template<typename Result>
+void bind(Result& result, ondemand::value object, uint64_t mask, UserTableOf<Result>& users) {
+    std::string path{};
+    bindMembers(object, result, path, mask, users);
+}
+
+// Results of a page are created with the allocator of the page's users.
+template<typename Result>
+Result bind(ondemand::value object, uint64_t mask, UserTableOf<Result>& users) {
+    Result result = makeValue<Result>(allocatorOf(users));
+    bind(result, object, mask, users);
+    return result;
+}
+
+template<typename Result>
+Result bind(ondemand::value object, uint64_t mask = ALL_FIELDS) {
+    UserTableOf<Result> users = makeUserTable<Result>(nullptr);
+    return bind<Result>(object, mask, users);
+}
+
+// follows, followed-by and tag feeds each name their cursor differently
+template<typename T>
+void getPagination(ondemand::value pagination, ResultCollection<T>& collection) {
+    std::string cursors[3]{};
+    forEachMember(pagination, [&](std::string_view key, ondemand::value value) {
+        if (key == "next_url") {
+            collection.setNextUrl(getString(value));
+        } else if (key == "next_max_id") {
+            cursors[0] = getString(value);
+        } else if (key == "next_max_tag_id") {
+            cursors[1] = getString(value);
+        } else if (key == "next_cursor") {
+            cursors[2] = getString(value);
+        }
+    });
+
+    for (std::string& cursor : cursors) {
+        if (!cursor.empty()) {
+            collection.setNextMaxId(std::move(cursor));
+            break;
+        }
+    }
+}
+
+AuthorizationToken parseAuthToken(std::string json) {
+    try {
+        AuthorizationToken token{};
+        bool hasToken = false;
+
+        ondemand::document document = iterate(json);
+        for (ondemand::field field : document.get_object()) {
+            const std::string_view key = field.unescaped_key().value();
+            if (key == "access_token") {
+                hasToken = true;
+                token.setAuthToken(getString(field.value()));
+            } else if (key == "user") {
+                token.setUserInfo(bind<UserInfo>(field.value()));
+            }
+        }
+
+        return hasToken ? token : AuthorizationToken{"Failed to parse access token"};
+    } catch (const simdjson_error&) {
+        return "Failed to parse access token";
+    }
+}
+
+template<typename Page>
+Page parseMediaPage(std::string json, MediaFields fields, PageArena arena) {
+    using Media = typename Page::value_type;
+    try {
+        Page result = makePage<Page>(std::move(arena));
+        UserTableOf<Media> users = makeUserTable<Media>(result.arena());
+
+        ondemand::document document = iterate(json);
+        const bool hasData = forData(document, [&result, &users, fields](ondemand::value data) {
+            forEachElement(data, [&result, &users, fields](ondemand::value media) {
+                result << bind<Media>(media, fields.bits(), users);
+            });
+        }, [&result](ondemand::value pagination) {
+            getPagination(pagination, result);
+        });
+
+        // returned by name, a conditional would copy the page out of its arena
+        if (!hasData) {
+            return "Failed to parse media entries";
+        }
+        return result;
+    } catch (const simdjson_error&) {
+        return "Failed to parse media entries";
+    }
+}
+
+MediaEntries parseMediaEntries(std::string json, MediaFields fields) {
+    return parseMediaPage<MediaEntries>(std::move(json), fields, nullptr);
+}
+
+ArenaMediaEntries parseMediaEntries(std::string json, MediaFields fields, PageArena arena) {
+    return parseMediaPage<ArenaMediaEntries>(std::move(json), fields, std::move(arena));
+}
+
+// Without the SAX reader the streamed overloads collect the body and parse it
+// in one go.
+static std::string readBody(Http::BodySource& body) {
+    std::string json{};
+    char buffer[16 * 1024];
+    for (size_t length = body.read(buffer, sizeof(buffer)); length > 0; length = body.read(buffer, sizeof(buffer))) {
+        json.append(buffer, length);
+    }
+    return json;
+}
+
+MediaEntries parseMediaEntries(Http::BodySource& body, MediaFields fields) {
+    return parseMediaEntries(readBody(body), fields);
+}
+
+ArenaMediaEntries parseMediaEntries(Http::BodySource& body, MediaFields fields, PageArena arena) {
+    return parseMediaEntries(readBody(body), fields, std::move(arena));
+}
+
+MediaEntry parseMediaEntry(std::string json, MediaFields fields) {
+    try {
+        MediaEntry entry{};
+
+        ondemand::document document = iterate(json);
+        const bool hasData = forData(document, [&entry, fields](ondemand::value data) { entry = bind<MediaEntry>(data, fields.bits()); });
+
+        return hasData ? entry : MediaEntry{"Failed to parse media entry"};
+    } catch (const simdjson_error&) {
+        return "Failed to parse media entry";
+    }
+}
+
+UserInfo parseUserInfo(std::string json, UserFields fields) {
+    try {
+        UserInfo userInfo{};
+
+        ondemand::document document = iterate(json);
+        const bool hasData = forData(document, [&userInfo, fields](ondemand::value data) { userInfo = bind<UserInfo>(data, fields.bits()); });
+
+        return hasData ? userInfo : UserInfo{"Failed to parse user info"};
+    } catch (const simdjson_error&) {
+        return "Failed to parse user info";
+    }
+}
+
+template<typename Page>
+Page parseUsersPage(std::string json, UserFields fields, PageArena arena) {
+    using User = typename Page::value_type;
+    try {
+        Page usersInfo = makePage<Page>(std::move(arena));
+        UserTableOf<User> users = makeUserTable<User>(usersInfo.arena());
+
+        ondemand::document document = iterate(json);
+        const bool hasData = forData(document, [&usersInfo, &users, fields](ondemand::value data) {
+            forEachElement(data, [&usersInfo, &users, fields](ondemand::value user) {
+                usersInfo << bind<User>(user, fields.bits(), users);
+            });
+        }, [&usersInfo](ondemand::value pagination) {
+            getPagination(pagination, usersInfo);
+        });
+
+        if (!hasData) {
+            return "Failed to parse users info";
+        }
+        return usersInfo;
+    } catch (const simdjson_error&) {
+        return "Failed to parse users info";
+    }
+}
+
+UsersInfo parseUsersInfo(std::string json, UserFields fields) {
+    return parseUsersPage<UsersInfo>(std::move(json), fields, nullptr);
+}
+
+ArenaUsersInfo parseUsersInfo(std::string json, UserFields fields, PageArena arena) {
+    return parseUsersPage<ArenaUsersInfo>(std::move(json), fields, std::move(arena));
+}
+
+UsersInfo parseUsersInfo(Http::BodySource& body, UserFields fields) {
+    return parseUsersInfo(readBody(body), fields);
+}
+
+ArenaUsersInfo parseUsersInfo(Http::BodySource& body, UserFields fields, PageArena arena) {
+    return parseUsersInfo(readBody(body), fields, std::move(arena));
+}
+
+MediaEntryViews parseMediaEntryViews(std::string json, MediaFields fields) {
+    try {
+        auto source = std::make_shared<ViewSource>(std::move(json));
+        MediaEntryViews result{source};
+
+        ondemand::document document = iterate(source->parser, source->json);
+        const bool hasData = forData(document, [&result, fields](ondemand::value data) {
+            forEachElement(data, [&result, fields](ondemand::value media) {
+                result << bind<MediaEntryView>(media, fields.bits());
+            });
+        }, [&result](ondemand::value pagination) {
+            getPagination(pagination, result);
+        });
+
+        if (!hasData) {
+            return "Failed to parse media entries";
+        }
+        return result;
+    } catch (const simdjson_error&) {
+        return "Failed to parse media entries";
+    }
+}
+
+UserInfoViews parseUsersInfoViews(std::string json, UserFields fields) {
+    try {
+        auto source = std::make_shared<ViewSource>(std::move(json));
+        UserInfoViews usersInfo{source};
+
+        ondemand::document document = iterate(source->parser, source->json);
+        const bool hasData = forData(document, [&usersInfo, fields](ondemand::value data) {
+            forEachElement(data, [&usersInfo, fields](ondemand::value user) {
+                usersInfo << bind<UserInfoView>(user, fields.bits());
+            });
+        }, [&usersInfo](ondemand::value pagination) {
+            getPagination(pagination, usersInfo);
+        });
+
+        if (!hasData) {
+            return "Failed to parse users info";
+        }
+        return usersInfo;
+    } catch (const simdjson_error&) {
+        return "Failed to parse users info";
+    }
+}
+
+RelationshipInfo parseRelationshipInfo(std::string json) {
+    try {
+        RelationshipInfo relationshipInfo{};
+
+        ondemand::document document = iterate(json);
+        const bool hasData = forData(document, [&relationshipInfo](ondemand::value data) {
+            relationshipInfo = bind<RelationshipInfo>(data);
+        });
+
+        return hasData ? relationshipInfo : RelationshipInfo{"Failed to parse relationship info"};
+    } catch (const simdjson_error&) {
+        return "Failed to parse relationship info";
+    }
+}
+
+TagInfo parseTagInfo(std::string json) {
+    try {
+        TagInfo tagInfo{};
+
+        ondemand::document document = iterate(json);
+        const bool hasData = forData(document, [&tagInfo](ondemand::value data) { tagInfo = bind<TagInfo>(data); });
+
+        return hasData ? tagInfo : TagInfo{"Failed to parse tag info"};
+    } catch (const simdjson_error&) {
+        return "Failed to parse tag info";
+    }
+}
+
+template<typename Page>
+Page parseTagsPage(std::string json, PageArena arena) {
+    using Tag = typename Page::value_type;
+    try {
+        Page tagsInfo = makePage<Page>(std::move(arena));
+        UserTableOf<Tag> users = makeUserTable<Tag>(tagsInfo.arena());
+
+        ondemand::document document = iterate(json);
+        const bool hasData = forData(document, [&tagsInfo, &users](ondemand::value data) {
+            forEachElement(data, [&tagsInfo, &users](ondemand::value tag) { tagsInfo << bind<Tag>(tag, ALL_FIELDS, users); });
+        });
+
+        if (!hasData) {
+            return "Failed to parse tags info";
+        }
+        return tagsInfo;
+    } catch (const simdjson_error&) {
+        return "Failed to parse tags info";
+    }
+}
+
+TagsInfo parseTagsInfo(std::string json) {
+    return parseTagsPage<TagsInfo>(std::move(json), nullptr);
+}
+
+ArenaTagsInfo parseTagsInfo(std::string json, PageArena arena) {
+    return parseTagsPage<ArenaTagsInfo>(std::move(json), std::move(arena));
+}
+
+template<typename Comment>
+Comment getCommentInfo(ondemand::value comment, UserTableOf<Comment>& users) {
+    if (isNull(comment)) {
+        return "Invalid json document, failed to parse comment";
+    }
+
+    return bind<Comment>(comment, ALL_FIELDS, users);
+}
+
+template<typename Page>
+Page parseCommentsPage(std::string json, PageArena arena) {
+    using Comment = typename Page::value_type;
+    try {
+        Page commentsInfo = makePage<Page>(std::move(arena));
+        UserTableOf<Comment> users = makeUserTable<Comment>(commentsInfo.arena());
+
+        ondemand::document document = iterate(json);
+        const bool hasData = forData(document, [&commentsInfo, &users](ondemand::value data) {
+            forEachElement(data, [&commentsInfo, &users](ondemand::value comment) { commentsInfo << getCommentInfo<Comment>(comment, users); });
+        });
+
+        if (!hasData) {
+            return "Failed to parse comments";
+        }
+        return commentsInfo;
+    } catch (const simdjson_error&) {
+        return "Failed to parse comments";
+    }
+}
+
+CommentsInfo parseComments(std::string json) {
+    return parseCommentsPage<CommentsInfo>(std::move(json), nullptr);
+}
+
+ArenaCommentsInfo parseComments(std::string json, PageArena arena) {
+    return parseCommentsPage<ArenaCommentsInfo>(std::move(json), std::move(arena));
+}
+
+template<typename Location>
+Location getLocation(ondemand::value location, UserTableOf<Location>& users) {
+    if (isNull(location)) {
+        return "Invalid json, failed to parse location";
+    }
+
+    return bind<Location>(location, ALL_FIELDS, users);
+}
+
+LocationInfo parseLocation(std::string json) {
+    try {
+        LocationInfo location{};
+        UserTable users{};
+
+        ondemand::document document = iterate(json);
+        const bool hasData = forData(document, [&location, &users](ondemand::value data) { location = getLocation<LocationInfo>(data, users); });
+
+        return hasData ? location : LocationInfo{"Failed to parse location"};
+    } catch (const simdjson_error&) {
+        return "Failed to parse location";
+    }
+}
+
+template<typename Page>
+Page parseLocationsPage(std::string json, PageArena arena) {
+    using Location = typename Page::value_type;
+    try {
+        Page infos = makePage<Page>(std::move(arena));
+        UserTableOf<Location> users = makeUserTable<Location>(infos.arena());
+
+        ondemand::document document = iterate(json);
+        const bool hasData = forData(document, [&infos, &users](ondemand::value data) {
+            forEachElement(data, [&infos, &users](ondemand::value location) { infos << getLocation<Location>(location, users); });
+        });
+
+        if (!hasData) {
+            return "Failed to parse locations";
+        }
+        return infos;
+    } catch (const simdjson_error&) {
+        return "Failed to parse locations";
+    }
+}
+
+LocationsInfo parseLocations(std::string json) {
+    return parseLocationsPage<LocationsInfo>(std::move(json), nullptr);
+}
+
+ArenaLocationsInfo parseLocations(std::string json, PageArena arena) {
+    return parseLocationsPage<ArenaLocationsInfo>(std::move(json), std::move(arena));
+}
+
+// Errors come either wrapped in a meta object or, from the oauth endpoints, as
+// top level members.
+std::string getError(std::string json) {
+    try {
+        int code = -1;
+        std::string errType{};
+        std::string errMsg{};
+        bool hasDetails = false;
+
+        auto readMeta = [&](std::string_view key, ondemand::value value) {
+            if (key == "code") {
+                code = getInt(value);
+            } else if (key == "error_type") {
+                hasDetails = hasDetails || !isNull(value);
+                errType = getString(value);
+            } else if (key == "error_message") {
+                hasDetails = hasDetails || !isNull(value);
+                errMsg = getString(value);
+            }
+        };
+
+        ondemand::document document = iterate(json);
+        for (ondemand::field field : document.get_object()) {
+            const std::string_view key = field.unescaped_key().value();
+            if (key == "meta") {
+                forEachMember(field.value(), readMeta);
+            } else {
+                readMeta(key, field.value());
+            }
+        }
+
+        if (code == 200) {
+            return " Call was successful";
+        }
+
+        if (hasDetails) {
+            return std::to_string(code) + " : " + errType + " - " + errMsg;
+        } else if (code != -1) {
+            return "Unknown error with code = " + std::to_string(code);
+        } else {
+            return "Unknown error";
+        }
+    } catch (const simdjson_error&) {
+        return "Failed to parse error";
+    }
+}
+
+}
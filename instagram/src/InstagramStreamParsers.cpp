@@ -0,0 +1,465 @@
+#include <cassert>
+#include <limits>
+#include <string>
+#include <vector>
+#include <rapidjson/reader.h>
+#include "InstagramParsers.h"
+#include "ResultSchema.hpp"
+
+using namespace rapidjson;
+
+namespace Instagram {
+
+static const size_t BODY_CHUNK_SIZE = 16 * 1024;
+
+// rapidjson input stream that pulls the body chunk by chunk as the parser
+// advances, so parsing starts with the first bytes received.
+class BodyStream{
+public:
+    typedef char Ch;
+
+    BodyStream(Http::BodySource& body) : m_body{body} {
+        fill();
+    }
+
+    Ch Peek() const{
+        return m_current < m_end ? *m_current : '\0';
+    }
+
+    Ch Take(){
+        if(m_current == m_end){
+            return '\0';
+        }
+
+        const Ch c = *m_current++;
+        ++m_count;
+        if(m_current == m_end){
+            fill();
+        }
+        return c;
+    }
+
+    size_t Tell() const{
+        return m_count;
+    }
+
+    Ch* PutBegin(){ assert(false); return nullptr; }
+    void Put(Ch){ assert(false); }
+    void Flush(){ assert(false); }
+    size_t PutEnd(Ch*){ assert(false); return 0; }
+private:
+    void fill(){
+        m_current = m_buffer.data();
+        m_end = m_current + m_body.read(m_buffer.data(), m_buffer.size());
+    }
+
+    Http::BodySource& m_body;
+    std::vector<Ch> m_buffer = std::vector<Ch>(BODY_CHUNK_SIZE);
+    const Ch* m_current{nullptr};
+    const Ch* m_end{nullptr};
+    size_t m_count{0};
+};
+
+// SAX handler keeping track of where the current token sits as a path like
+// "/data/[]/images/thumbnail/url", array elements show up as "[]". Derived
+// handlers only see strings, ints and the start and end of objects, and only
+// the strings and ints at paths they want.
+template<typename Derived>
+class PathHandler{
+public:
+    bool Null(){ return skip(); }
+    bool Bool(bool){ return skip(); }
+    bool Int(int value){ return integer(value); }
+    bool Uint(unsigned value){
+        return value <= static_cast<unsigned>(std::numeric_limits<int>::max()) ? integer(static_cast<int>(value)) : skip();
+    }
+    bool Int64(int64_t){ return skip(); }
+    bool Uint64(uint64_t){ return skip(); }
+    bool Double(double){ return skip(); }
+    bool RawNumber(const char*, SizeType, bool){ return skip(); }
+
+    bool String(const char* str, SizeType length, bool){
+        const size_t parentLength = enter();
+        const bool result = !derived().wants(m_path) || derived().onString(m_path, std::string_view{str, length});
+        m_path.resize(parentLength);
+        return result;
+    }
+
+    bool Key(const char* str, SizeType length, bool){
+        m_containers.back().key.assign(str, length);
+        return true;
+    }
+
+    bool StartObject(){
+        m_containers.push_back({false, {}, enter()});
+        return derived().onStartObject(m_path);
+    }
+
+    bool EndObject(SizeType){
+        const bool result = derived().onEndObject(m_path);
+        leave();
+        return result;
+    }
+
+    bool StartArray(){
+        m_containers.push_back({true, {}, enter()});
+        return true;
+    }
+
+    bool EndArray(SizeType){
+        leave();
+        return true;
+    }
+
+    void onValue(const std::string&){}
+    bool wants(const std::string&) const{ return true; }
+    bool onString(const std::string&, std::string_view){ return true; }
+    bool onInt(const std::string&, int){ return true; }
+    bool onStartObject(const std::string&){ return true; }
+    bool onEndObject(const std::string&){ return true; }
+private:
+    struct Container{
+        bool array;
+        std::string key;
+        size_t parentLength;
+    };
+
+    Derived& derived(){
+        return static_cast<Derived&>(*this);
+    }
+
+    // Appends the segment of the value about to start and returns the length
+    // of the path without it.
+    size_t enter(){
+        const size_t parentLength = m_path.size();
+        if(!m_containers.empty()){
+            m_path += '/';
+            m_path += m_containers.back().array ? "[]" : m_containers.back().key;
+        }
+        derived().onValue(m_path);
+        return parentLength;
+    }
+
+    void leave(){
+        m_path.resize(m_containers.back().parentLength);
+        m_containers.pop_back();
+    }
+
+    bool integer(int value){
+        const size_t parentLength = enter();
+        const bool result = !derived().wants(m_path) || derived().onInt(m_path, value);
+        m_path.resize(parentLength);
+        return result;
+    }
+
+    bool skip(){
+        return true;
+    }
+
+    std::string m_path{};
+    std::vector<Container> m_containers{};
+};
+
+static bool startsWith(const std::string& str, const char* prefix, size_t length){
+    return str.compare(0, length, prefix) == 0;
+}
+
+// A string value the way the setters of Result take it, arena results copy
+// the characters straight into their arena.
+template<typename Result>
+static auto setterString(std::string_view value){
+    if constexpr (std::uses_allocator<Result, ResultAllocator>::value){
+        return value;
+    }else{
+        return std::string{value};
+    }
+}
+
+template<typename User>
+static void setUserField(User& userInfo, const std::string& field, std::string_view value){
+    if(field == "id"){
+        userInfo.setId(setterString<User>(value));
+    }else if(field == "username"){
+        userInfo.setUsername(setterString<User>(value));
+    }else if(field == "profile_picture"){
+        userInfo.setProfilePictureUrl(setterString<User>(value));
+    }else if(field == "full_name"){
+        userInfo.setFullName(setterString<User>(value));
+    }else if(field == "bio"){
+        userInfo.setBio(setterString<User>(value));
+    }else if(field == "website"){
+        userInfo.setWebsite(setterString<User>(value));
+    }
+}
+
+template<typename User>
+static void setUserCount(User& userInfo, const std::string& field, int value){
+    if(field == "counts/followed_by"){
+        userInfo.setFollowedBy(value);
+    }else if(field == "counts/follows"){
+        userInfo.setFollows(value);
+    }else if(field == "counts/media"){
+        userInfo.setMediaCount(value);
+    }
+}
+
+static const char ELEMENT[] = "/data/[]";
+
+static const char FIELD[] = "/data/[]/";
+static const size_t FIELD_LENGTH = sizeof(FIELD) - 1;
+static const char USER[] = "/data/[]/user";
+
+// whether the element field at path belongs to a field in mask
+template<typename Result>
+static bool inMask(const std::string& path, uint64_t mask){
+    return mask == ALL_FIELDS || !startsWith(path, FIELD, FIELD_LENGTH) ||
+           (maskOf<Result>(std::string_view{path}.substr(FIELD_LENGTH)) & mask) != 0;
+}
+
+// Collects the pagination object and notices the data member, the part both
+// kinds of pages have in common.
+template<typename Derived, typename Page>
+class PageHandler : public PathHandler<Derived>{
+public:
+    PageHandler(PageArena arena) : m_page{makePage<Page>(std::move(arena))} {}
+
+    void onValue(const std::string& path){
+        m_hasData = m_hasData || path == "/data";
+    }
+
+    bool onString(const std::string& path, std::string_view value){
+        if(path == "/pagination/next_url"){
+            m_nextUrl = value;
+        }else if(path == "/pagination/next_max_id"){
+            m_cursors[0] = value;
+        }else if(path == "/pagination/next_max_tag_id"){
+            m_cursors[1] = value;
+        }else if(path == "/pagination/next_cursor"){
+            m_cursors[2] = value;
+        }
+        return true;
+    }
+
+    bool hasData() const noexcept{
+        return m_hasData;
+    }
+
+    // The cursor names take precedence in the same order as for the document
+    // parsers.
+    Page finish(){
+        m_page.setNextUrl(std::move(m_nextUrl));
+        for(std::string& cursor : m_cursors){
+            if(!cursor.empty()){
+                m_page.setNextMaxId(std::move(cursor));
+                break;
+            }
+        }
+        return std::move(m_page);
+    }
+protected:
+    Page m_page;
+private:
+    std::string m_nextUrl{};
+    std::string m_cursors[3]{};
+    bool m_hasData{false};
+};
+
+template<typename Page>
+class MediaPageHandler : public PageHandler<MediaPageHandler<Page>, Page>{
+    using Media = typename Page::value_type;
+    using User = std::decay_t<decltype(std::declval<const Media&>().userInfo())>;
+    using Base = PageHandler<MediaPageHandler<Page>, Page>;
+    using Base::m_page;
+public:
+    // The entry being read lives in the page's arena from the start, so adding
+    // it to the page moves it. Its user is read on the heap and interned, the
+    // arena only gets the users not seen before.
+    MediaPageHandler(uint64_t mask, PageArena arena) : Base{std::move(arena)}, m_mask{mask},
+                                                       m_users{makeUserTable<Media>(m_page.arena())},
+                                                       m_entry{makeValue<Media>(allocatorOf(m_page))} {}
+
+    bool wants(const std::string& path) const{
+        return inMask<Media>(path, m_mask);
+    }
+
+    bool onStartObject(const std::string& path){
+        if(path == ELEMENT){
+            m_entry = makeValue<Media>(allocatorOf(m_page));
+            m_user = User{};
+            m_hasUser = false;
+            m_videoLow.clear();
+            m_videoStandart.clear();
+        }else if(path == USER){
+            m_hasUser = true;
+        }
+        return true;
+    }
+
+    bool onEndObject(const std::string& path){
+        if(path == ELEMENT){
+            if(m_entry.type() == MediaType::VIDEO){
+                m_entry.setVideoLowResolution(m_videoLow);
+                m_entry.setVideoStandartResolution(m_videoStandart);
+            }
+            if(m_hasUser){
+                m_entry.setUserInfo(m_users.intern(std::move(m_user)));
+            }
+            m_page << std::move(m_entry);
+        }
+        return true;
+    }
+
+    bool onString(const std::string& path, std::string_view value){
+        if(!startsWith(path, FIELD, FIELD_LENGTH)){
+            return Base::onString(path, value);
+        }
+
+        const std::string field = path.substr(FIELD_LENGTH);
+        if(field == "id"){
+            m_entry.setId(setterString<Media>(value));
+        }else if(field == "link"){
+            m_entry.setLink(setterString<Media>(value));
+        }else if(field == "filter"){
+            m_entry.setFilter(setterString<Media>(value));
+        }else if(field == "type"){
+            if(value == "image"){
+                m_entry.setType(MediaType::IMAGE);
+            }else if(value == "video"){
+                m_entry.setType(MediaType::VIDEO);
+            }
+        }else if(field == "created_time"){
+            m_entry.setCreateTime(toTime(value));
+        }else if(field == "caption/text"){
+            m_entry.setCaption(setterString<Media>(value));
+        }else if(field == "images/low_resolution/url"){
+            m_entry.setLowResolution(setterString<Media>(value));
+        }else if(field == "images/thumbnail/url"){
+            m_entry.setThumbnail(setterString<Media>(value));
+        }else if(field == "images/standard_resolution/url"){
+            m_entry.setStandartResolution(setterString<Media>(value));
+        }else if(field == "videos/low_resolution"){
+            m_videoLow = value;
+        }else if(field == "videos/standart_resolution"){
+            m_videoStandart = value;
+        }else if(field == "tags/[]"){
+            m_entry.addTag(setterString<Media>(value));
+        }else if(field == "users_in_photo/[]"){
+            m_entry.addUser(setterString<Media>(value));
+        }else if(startsWith(field, "user/", 5)){
+            setUserField(m_user, field.substr(5), value);
+        }
+        return true;
+    }
+
+    bool onInt(const std::string& path, int value){
+        if(!startsWith(path, FIELD, FIELD_LENGTH)){
+            return true;
+        }
+
+        const std::string field = path.substr(FIELD_LENGTH);
+        if(field == "comments/count"){
+            m_entry.setCommentsCount(value);
+        }else if(field == "likes/count"){
+            m_entry.setLikeCount(value);
+        }else if(startsWith(field, "user/", 5)){
+            setUserCount(m_user, field.substr(5), value);
+        }
+        return true;
+    }
+private:
+    uint64_t m_mask;
+    UserTableOf<Media> m_users;
+    Media m_entry;
+    User m_user{};
+    bool m_hasUser{false};
+    std::string m_videoLow{};
+    std::string m_videoStandart{};
+};
+
+template<typename Page>
+class UsersPageHandler : public PageHandler<UsersPageHandler<Page>, Page>{
+    using User = typename Page::value_type;
+    using Base = PageHandler<UsersPageHandler<Page>, Page>;
+    using Base::m_page;
+public:
+    UsersPageHandler(uint64_t mask, PageArena arena) : Base{std::move(arena)}, m_mask{mask}, m_user{makeValue<User>(allocatorOf(m_page))} {}
+
+    bool wants(const std::string& path) const{
+        return inMask<User>(path, m_mask);
+    }
+
+    bool onStartObject(const std::string& path){
+        if(path == ELEMENT){
+            m_user = makeValue<User>(allocatorOf(m_page));
+        }
+        return true;
+    }
+
+    bool onEndObject(const std::string& path){
+        if(path == ELEMENT){
+            m_page << std::move(m_user);
+        }
+        return true;
+    }
+
+    bool onString(const std::string& path, std::string_view value){
+        if(!startsWith(path, FIELD, FIELD_LENGTH)){
+            return Base::onString(path, value);
+        }
+
+        setUserField(m_user, path.substr(FIELD_LENGTH), value);
+        return true;
+    }
+
+    bool onInt(const std::string& path, int value){
+        if(startsWith(path, FIELD, FIELD_LENGTH)){
+            setUserCount(m_user, path.substr(FIELD_LENGTH), value);
+        }
+        return true;
+    }
+private:
+    uint64_t m_mask;
+    User m_user;
+};
+
+template<typename Page>
+Page parseMediaPage(Http::BodySource& body, MediaFields fields, PageArena arena) {
+    BodyStream stream{body};
+    MediaPageHandler<Page> handler{fields.bits(), std::move(arena)};
+    Reader reader{};
+
+    if (reader.Parse(stream, handler).IsError() || !handler.hasData()) {
+        return "Failed to parse media entries";
+    }
+    return handler.finish();
+}
+
+MediaEntries parseMediaEntries(Http::BodySource& body, MediaFields fields) {
+    return parseMediaPage<MediaEntries>(body, fields, nullptr);
+}
+
+ArenaMediaEntries parseMediaEntries(Http::BodySource& body, MediaFields fields, PageArena arena) {
+    return parseMediaPage<ArenaMediaEntries>(body, fields, std::move(arena));
+}
+
+template<typename Page>
+Page parseUsersPage(Http::BodySource& body, UserFields fields, PageArena arena) {
+    BodyStream stream{body};
+    UsersPageHandler<Page> handler{fields.bits(), std::move(arena)};
+    Reader reader{};
+
+    if (reader.Parse(stream, handler).IsError() || !handler.hasData()) {
+        return "Failed to parse users info";
+    }
+    return handler.finish();
+}
+
+UsersInfo parseUsersInfo(Http::BodySource& body, UserFields fields) {
+    return parseUsersPage<UsersInfo>(body, fields, nullptr);
+}
+
+ArenaUsersInfo parseUsersInfo(Http::BodySource& body, UserFields fields, PageArena arena) {
+    return parseUsersPage<ArenaUsersInfo>(body, fields, std::move(arena));
+}
+
+}
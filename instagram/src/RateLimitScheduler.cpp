@@ -0,0 +1,187 @@
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <limits>
+#include <thread>
+
+#include "RateLimitScheduler.h"
+#include "InstagramConstants.h"
+
+#include "HttpRequest.h"
+#include "HttpResponse.h"
+
+namespace Instagram {
+
+static const char* RATELIMIT_LIMIT = "X-Ratelimit-Limit";
+static const char* RATELIMIT_REMAINING = "X-Ratelimit-Remaining";
+
+static long parseCount(const std::string& value){
+    const auto begin = std::find_if(value.begin(), value.end(), [](char c) { return !std::isspace(static_cast<unsigned char>(c)); });
+    if (begin == value.end() || !std::all_of(begin, value.end(), [](unsigned char c) { return std::isdigit(c); })) {
+        return -1;
+    }
+
+    // runs inside a response observer, a count that does not fit is ignored
+    // rather than thrown
+    errno = 0;
+    const long count = std::strtol(&*begin, nullptr, 10);
+    return errno == ERANGE ? -1 : count;
+}
+
+RateLimitScheduler::RateLimitScheduler(std::chrono::seconds window) : m_window{window} {}
+
+void RateLimitScheduler::wait(const Http::HttpRequest& request) {
+    const std::string token = authToken(request);
+    if (token.empty()) {
+        return;
+    }
+
+    std::this_thread::sleep_until(reserve(token));
+}
+
+bool RateLimitScheduler::tryPass(const Http::HttpRequest& request) {
+    const std::string token = authToken(request);
+    if (token.empty()) {
+        return true;
+    }
+
+    const Clock::time_point now = Clock::now();
+
+    std::lock_guard<std::mutex> lock{m_mutex};
+    TokenState& state = m_tokens[token];
+    startWindow(state, now);
+
+    if (state.blockedUntil > now) {
+        return false;
+    }
+    if (state.budget.remaining < 0) {
+        return true;
+    }
+    if (state.budget.remaining - state.reserved <= 0) {
+        return false;
+    }
+
+    // no response is reported for it, so it is counted right away instead of
+    // being reserved
+    --state.budget.remaining;
+    return true;
+}
+
+void RateLimitScheduler::onResponse(const Http::HttpRequest& request, const Http::HttpResponse& response, const Http::RequestTimings& timings) {
+    const std::string token = authToken(request);
+    if (token.empty() || timings.cached) {
+        return;
+    }
+
+    const Clock::time_point now = Clock::now();
+    const long limit = parseCount(response[RATELIMIT_LIMIT]);
+    const long remaining = parseCount(response[RATELIMIT_REMAINING]);
+
+    std::lock_guard<std::mutex> lock{m_mutex};
+    TokenState& state = m_tokens[token];
+
+    state.reserved = std::max(state.reserved - 1, 0l);
+
+    if (limit >= 0) {
+        state.budget.limit = limit;
+    }
+    if (remaining >= 0) {
+        state.budget.remaining = remaining;
+    } else if (response.code() >= 0 && state.budget.remaining > 0) {
+        // reached the API without telling what is left, assume it was counted
+        --state.budget.remaining;
+    }
+
+    if (response.code() == Http::Status::TOO_MANY_REQUESTS) {
+        state.budget.remaining = 0;
+
+        // the budget is back after one window anyway, a longer Retry-After is
+        // capped there instead of overflowing the time point
+        const long retryAfter = parseCount(response[Http::Header::RETRY_AFTER]);
+        const long windowSeconds = static_cast<long>(std::chrono::duration_cast<std::chrono::seconds>(m_window).count());
+        state.blockedUntil = retryAfter >= 0 ? now + std::chrono::seconds{std::min(retryAfter, windowSeconds)}
+                                             : std::max(state.windowEnd, now + m_window / 60);
+    }
+}
+
+RateLimitScheduler::Budget RateLimitScheduler::budget(const std::string& authToken) const {
+    std::lock_guard<std::mutex> lock{m_mutex};
+
+    auto it = m_tokens.find(authToken);
+    return it == m_tokens.end() ? Budget{} : it->second.budget;
+}
+
+long RateLimitScheduler::available(const std::string& authToken) const {
+    std::lock_guard<std::mutex> lock{m_mutex};
+
+    auto it = m_tokens.find(authToken);
+    if (it == m_tokens.end() || it->second.budget.remaining < 0) {
+        return std::numeric_limits<long>::max();
+    }
+    const TokenState& state = it->second;
+    const Clock::time_point now = Clock::now();
+    if (state.blockedUntil > now) {
+        return 0;
+    }
+
+    if (state.windowEnd <= now && state.budget.limit < 0) {
+        return std::numeric_limits<long>::max();
+    }
+
+    const long remaining = state.windowEnd <= now ? state.budget.limit : state.budget.remaining;
+    return std::max(remaining - state.reserved, 0l);
+}
+
+RateLimitScheduler::Clock::time_point RateLimitScheduler::reserve(const std::string& authToken) {
+    const Clock::time_point now = Clock::now();
+
+    std::lock_guard<std::mutex> lock{m_mutex};
+    TokenState& state = m_tokens[authToken];
+    startWindow(state, now);
+
+    Clock::time_point start = std::max({now, state.nextSlot, state.blockedUntil});
+
+    // nothing is known before the first response, so nothing to pace against
+    if (state.budget.remaining < 0) {
+        ++state.reserved;
+        return start;
+    }
+
+    long available = state.budget.remaining - state.reserved;
+    Clock::time_point windowEnd = state.windowEnd;
+
+    if (available <= 0 && state.budget.limit < 0) {
+        // spent without knowing how much the next window brings, nothing to
+        // pace against until it starts
+        start = std::max(start, state.windowEnd);
+        state.nextSlot = start;
+        ++state.reserved;
+        return start;
+    }
+
+    if (available <= 0) {
+        // the budget is spent, queue up for the next window
+        start = std::max(start, state.windowEnd);
+        available = std::max(state.budget.limit - (state.reserved - state.budget.remaining), 1l);
+        windowEnd = state.windowEnd + m_window;
+    }
+
+    state.nextSlot = start + (windowEnd - start) / available;
+    ++state.reserved;
+    return start;
+}
+
+void RateLimitScheduler::startWindow(TokenState& state, Clock::time_point now) const {
+    if (state.windowEnd <= now) {
+        state.windowEnd = now + m_window;
+        // without a limit reported what the new window holds is unknown
+        state.budget.remaining = state.budget.limit;
+    }
+}
+
+std::string RateLimitScheduler::authToken(const Http::HttpRequest& request) {
+    return request.getUrl().argument(AUTH_TOKEN_ARG);
+}
+
+}
@@ -0,0 +1,59 @@
+#ifndef ARENA_COMMENT_INFO_H
+#define ARENA_COMMENT_INFO_H
+
+#include <memory_resource>
+#include <string_view>
+#include "BaseResult.h"
+#include "ResultAllocator.hpp"
+#include "ArenaUserInfo.h"
+#include "ArenaUserTable.h"
+
+namespace Instagram{
+
+// CommentInfo allocating its strings from the arena of its page.
+class EXPORT_INSTAGRAM ArenaCommentInfo : public BaseResult{
+public:
+    using allocator_type = ResultAllocator;
+
+    ArenaCommentInfo();
+    explicit ArenaCommentInfo(const allocator_type& allocator);
+    ArenaCommentInfo(std::string_view text, std::string_view id, long createTime, const ArenaUserInfo& userInfo);
+    ArenaCommentInfo(const ArenaCommentInfo& commentInfo);
+    ArenaCommentInfo(const ArenaCommentInfo& commentInfo, const allocator_type& allocator);
+    ArenaCommentInfo(ArenaCommentInfo&& commentInfo);
+    ArenaCommentInfo(ArenaCommentInfo&& commentInfo, const allocator_type& allocator);
+    ArenaCommentInfo(const std::string& errMsg);
+    ArenaCommentInfo(const char* errMsg);
+
+    ~ArenaCommentInfo();
+
+    ArenaCommentInfo& operator=(const ArenaCommentInfo& commentInfo);
+    ArenaCommentInfo& operator=(ArenaCommentInfo&& commentInfo);
+
+    allocator_type get_allocator() const noexcept;
+
+    std::string_view text() const noexcept;
+    std::string_view id() const noexcept;
+    long createTime() const noexcept;
+    const ArenaUserInfo& userInfo() const noexcept;
+    // shared with the other results of its page by the same user
+    const ArenaUserHandle& sharedUserInfo() const noexcept;
+
+    void setText(std::string_view text);
+    void setId(std::string_view id_);
+    void setCreateTime(long createdTime);
+    void setUserInfo(const ArenaUserInfo& userInfo);
+    void setUserInfo(ArenaUserInfo&& userInfo);
+    void setUserInfo(ArenaUserHandle userInfo);
+private:
+    std::pmr::string m_text{""};
+    std::pmr::string m_id {""};
+    long m_createTime = -1;
+    ArenaUserHandle m_userInfo{};
+
+    // only for comments sharing an allocator
+    friend void swap(ArenaCommentInfo& first, ArenaCommentInfo& second);
+};
+
+}
+#endif
@@ -0,0 +1,16 @@
+#ifndef ARENA_COMMENTS_INFO_H
+#define ARENA_COMMENTS_INFO_H
+
+#include "ResultCollection.hpp"
+#include "ArenaCommentInfo.h"
+
+namespace Instagram{
+
+using ArenaCommentsInfo = ResultCollection<ArenaCommentInfo>;
+
+#ifdef WIN32
+INSTAGRAM_EXP_TMP template class EXPORT_INSTAGRAM ResultCollection<ArenaCommentInfo>;
+#endif
+
+}
+#endif
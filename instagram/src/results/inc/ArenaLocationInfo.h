@@ -0,0 +1,52 @@
+#ifndef ARENA_LOCATION_INFO_H
+#define ARENA_LOCATION_INFO_H
+
+#include <memory_resource>
+#include <string_view>
+#include "BaseResult.h"
+#include "ResultAllocator.hpp"
+
+namespace Instagram{
+
+// LocationInfo allocating its strings from the arena of its page.
+class EXPORT_INSTAGRAM ArenaLocationInfo : public BaseResult{
+public:
+    using allocator_type = ResultAllocator;
+
+    ArenaLocationInfo();
+    explicit ArenaLocationInfo(const allocator_type& allocator);
+    ArenaLocationInfo(const ArenaLocationInfo& locInfo);
+    ArenaLocationInfo(const ArenaLocationInfo& locInfo, const allocator_type& allocator);
+    ArenaLocationInfo(ArenaLocationInfo&& locInfo);
+    ArenaLocationInfo(ArenaLocationInfo&& locInfo, const allocator_type& allocator);
+    ArenaLocationInfo(const std::string& errMsg);
+    ArenaLocationInfo(const char* errMsg);
+
+    ArenaLocationInfo& operator=(const ArenaLocationInfo& locInfo);
+    ArenaLocationInfo& operator=(ArenaLocationInfo&& locInfo);
+
+    allocator_type get_allocator() const noexcept;
+
+    std::string_view id() const;
+    std::string_view name() const;
+    double latitude() const;
+    double longitude() const;
+
+    void setId(std::string_view id);
+    void setName(std::string_view name);
+    void setLatitude(double lat);
+    void setLongitude(double lng);
+private:
+    std::pmr::string m_id{""};
+    std::pmr::string m_name{""};
+    double m_lat{-1};
+    double m_lng{-1};
+
+    // only for locations sharing an allocator
+    friend void swap(ArenaLocationInfo& first, ArenaLocationInfo& second);
+};
+
+}
+
+
+#endif
@@ -0,0 +1,16 @@
+#ifndef ARENA_LOCATIONS_INFO_H
+#define ARENA_LOCATIONS_INFO_H
+
+#include "ResultCollection.hpp"
+#include "ArenaLocationInfo.h"
+
+namespace Instagram{
+
+using ArenaLocationsInfo = ResultCollection<ArenaLocationInfo>;
+
+#ifdef WIN32
+INSTAGRAM_EXP_TMP template class EXPORT_INSTAGRAM ResultCollection<ArenaLocationInfo>;
+#endif
+
+}
+#endif
@@ -0,0 +1,16 @@
+#ifndef ARENA_MEDIA_ENTRIES_H
+#define ARENA_MEDIA_ENTRIES_H
+
+#include "ResultCollection.hpp"
+#include "ArenaMediaEntry.h"
+
+namespace Instagram{
+
+using ArenaMediaEntries = ResultCollection<ArenaMediaEntry>;
+
+#ifdef WIN32
+INSTAGRAM_EXP_TMP template class EXPORT_INSTAGRAM ResultCollection<ArenaMediaEntry>;
+#endif
+
+}
+#endif
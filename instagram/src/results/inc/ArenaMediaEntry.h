@@ -0,0 +1,113 @@
+#ifndef ARENA_MEDIA_ENTRY
+#define ARENA_MEDIA_ENTRY
+
+#include <memory_resource>
+#include <vector>
+#include <string>
+#include <string_view>
+#include "ArenaUserInfo.h"
+#include "ArenaUserTable.h"
+#include "MediaEntry.h"
+
+namespace Instagram{
+#ifdef WIN32
+INSTAGRAM_EXP_TMP template class EXPORT_INSTAGRAM std::vector<std::pmr::string, std::pmr::polymorphic_allocator<std::pmr::string>>;
+#endif
+
+// MediaEntry allocating its strings, tags and users in photo from the arena
+// of the page it is created for. Moved or copied out of the page it lands on
+// the heap.
+class EXPORT_INSTAGRAM ArenaMediaEntry : public BaseResult{
+public:
+    using allocator_type = ResultAllocator;
+
+    ArenaMediaEntry();
+    explicit ArenaMediaEntry(const allocator_type& allocator);
+    ArenaMediaEntry(const std::string& errMsg);
+    ArenaMediaEntry(const char* errMsg);
+    ArenaMediaEntry(const ArenaMediaEntry& mediaEntry);
+    ArenaMediaEntry(const ArenaMediaEntry& mediaEntry, const allocator_type& allocator);
+    ArenaMediaEntry(ArenaMediaEntry&& mediaEntry);
+    ArenaMediaEntry(ArenaMediaEntry&& mediaEntry, const allocator_type& allocator);
+    ~ArenaMediaEntry();
+
+    ArenaMediaEntry& operator=(const ArenaMediaEntry& mediaEntry);
+    ArenaMediaEntry& operator=(ArenaMediaEntry&& mediaEntry);
+
+    allocator_type get_allocator() const noexcept;
+
+    MediaType type() const noexcept;
+    std::string_view link() const noexcept;
+    std::string_view id() const noexcept;
+    std::string_view caption() const noexcept;
+    std::string_view standartResolution() const noexcept;
+    std::string_view thumbnail() const noexcept;
+    std::string_view lowResolution() const noexcept;
+    std::string_view filter() const noexcept;
+
+    std::string_view videoLowResolution() const noexcept;
+    std::string_view videoStandartResolution() const noexcept;
+
+    const std::pmr::vector<std::pmr::string>& tags() const noexcept;
+    const std::pmr::vector<std::pmr::string>& usersInPhoto() const noexcept;
+
+    const ArenaUserInfo& userInfo() const noexcept;
+    // shared with the other results of its page by the same user
+    const ArenaUserHandle& sharedUserInfo() const noexcept;
+
+    int commentsCount() const noexcept;
+    int likesCount() const noexcept;
+    long createTime() const noexcept;
+
+    void setType(MediaType type);
+    void setLink(std::string_view link);
+    void setId(std::string_view id);
+    void setCaption(std::string_view caption);
+    void setStandartResolution(std::string_view url);
+    void setThumbnail(std::string_view url);
+    void setLowResolution(std::string_view url);
+    void setFilter(std::string_view filter);
+
+    void setVideoLowResolution(std::string_view url);
+    void setVideoStandartResolution(std::string_view url);
+
+    void setCommentsCount(int count);
+    void setLikeCount(int count);
+    void setCreateTime(long time);
+
+    void addTag(std::string_view tag);
+    void addUser(std::string_view userId);
+
+    // a user set by value is kept on the heap, pages share theirs through
+    // a ArenaUserTable
+    void setUserInfo(const ArenaUserInfo& userInfo);
+    void setUserInfo(ArenaUserInfo&& userInfo);
+    void setUserInfo(ArenaUserHandle userInfo);
+private:
+    std::pmr::string m_link{};
+    std::pmr::string m_id{};
+    std::pmr::string m_caption{};
+    std::pmr::string m_lowResolution{};
+    std::pmr::string m_thumbnail{};
+    std::pmr::string m_standartResolution{};
+    std::pmr::string m_filter{};
+
+    std::pmr::string m_videoLow{};
+    std::pmr::string m_videoStandart{};
+
+    std::pmr::vector<std::pmr::string> m_tags;
+    std::pmr::vector<std::pmr::string> m_users;
+
+    ArenaUserHandle m_userInfo{};
+
+    int m_commentsCount = -1;
+    int m_likesCount = -1;
+    long m_createTime = -1;
+    MediaType m_mediaType = MediaType::UNKNOWN;
+    
+    // only for entries sharing an allocator
+    friend void swap(ArenaMediaEntry& media1, ArenaMediaEntry& media2);
+};
+
+}
+#endif
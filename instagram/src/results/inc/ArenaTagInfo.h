@@ -0,0 +1,49 @@
+#ifndef ARENA_TAG_INFO_H
+#define ARENA_TAG_INFO_H
+
+#include <memory_resource>
+#include <string_view>
+#include "BaseResult.h"
+#include "ResultAllocator.hpp"
+
+namespace Instagram{
+
+// TagInfo allocating its name from the arena of its page.
+class EXPORT_INSTAGRAM ArenaTagInfo : public BaseResult{
+public:
+    using allocator_type = ResultAllocator;
+
+    ArenaTagInfo();
+    explicit ArenaTagInfo(const allocator_type& allocator);
+    ArenaTagInfo(std::string_view name, int count);
+    ArenaTagInfo(const char* errMsg);
+    ArenaTagInfo(const std::string& errMsg);
+    ArenaTagInfo(const ArenaTagInfo& tagInfo);
+    ArenaTagInfo(const ArenaTagInfo& tagInfo, const allocator_type& allocator);
+    ArenaTagInfo(ArenaTagInfo&& tagInfo);
+    ArenaTagInfo(ArenaTagInfo&& tagInfo, const allocator_type& allocator);
+
+    ~ArenaTagInfo();
+
+    ArenaTagInfo& operator=(const ArenaTagInfo& tagInfo);
+    ArenaTagInfo& operator=(ArenaTagInfo&& tagInfo);
+
+    allocator_type get_allocator() const noexcept;
+
+    std::string_view name() const noexcept;
+    int count() const noexcept;
+
+    void setName(std::string_view name);
+    void setCount(int count);
+private:
+    std::pmr::string m_name{};
+    int m_count{-1};
+
+    // only for tags sharing an allocator
+    friend void swap(ArenaTagInfo& first, ArenaTagInfo& second);
+};
+
+}
+
+#endif
+
@@ -0,0 +1,16 @@
+#ifndef ARENA_TAGS_INFO_H
+#define ARENA_TAGS_INFO_H
+
+#include "ResultCollection.hpp"
+#include "ArenaTagInfo.h"
+
+namespace Instagram{
+
+using ArenaTagsInfo = ResultCollection<ArenaTagInfo>;
+
+#ifdef WIN32
+INSTAGRAM_EXP_TMP template class EXPORT_INSTAGRAM ResultCollection<ArenaTagInfo>;
+#endif
+
+}
+#endif
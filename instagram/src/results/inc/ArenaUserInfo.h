@@ -0,0 +1,73 @@
+#ifndef ARENA_USER_INFO_H
+#define ARENA_USER_INFO_H
+
+#include <memory_resource>
+#include <string_view>
+#include "BaseResult.h"
+#include "ResultAllocator.hpp"
+
+namespace Instagram{
+
+// UserInfo allocating its strings from the arena of the page it is created
+// for, the string getters point into it.
+class EXPORT_INSTAGRAM ArenaUserInfo : public BaseResult{
+public:
+    using allocator_type = ResultAllocator;
+
+    ArenaUserInfo();
+    explicit ArenaUserInfo(const allocator_type& allocator);
+    ArenaUserInfo(const ArenaUserInfo& userInfo);
+    ArenaUserInfo(const ArenaUserInfo& userInfo, const allocator_type& allocator);
+    ArenaUserInfo(ArenaUserInfo&& userInfo);
+    ArenaUserInfo(ArenaUserInfo&& userInfo, const allocator_type& allocator);
+
+    ArenaUserInfo(const char* errMsg);
+    ArenaUserInfo(const std::string& errMsg);
+
+    ~ArenaUserInfo();
+
+    ArenaUserInfo& operator=(const ArenaUserInfo& userInfo);
+    ArenaUserInfo& operator=(ArenaUserInfo&& userInfo);
+
+    allocator_type get_allocator() const noexcept;
+
+    std::string_view id() const noexcept;
+    std::string_view username() const noexcept;
+    std::string_view fullName() const noexcept;
+    std::string_view bio() const noexcept;
+    std::string_view profilePictureUrl() const noexcept;
+    std::string_view website() const noexcept;
+
+    int followedBy() const noexcept;
+    int follows() const noexcept;
+    int mediaCount() const noexcept;
+
+    void setId(std::string_view id);
+    void setUsername(std::string_view username);
+    void setFullName(std::string_view name);
+    void setBio(std::string_view bio);
+    void setProfilePictureUrl(std::string_view profPicUrl);
+    void setWebsite(std::string_view website);
+
+    void setFollowedBy(int count);
+    void setFollows(int count);
+    void setMediaCount(int count);
+private:
+    std::pmr::string m_id{};
+    std::pmr::string m_username{};
+    std::pmr::string m_fullName{};
+    std::pmr::string m_bio{};
+    std::pmr::string m_profPicUrl{};
+    std::pmr::string m_website{};
+
+    int m_followedBy{-1};
+    int m_follows{-1};
+    int m_mediaCount{-1};
+
+    // only for users sharing an allocator
+    friend void swap(ArenaUserInfo& info1, ArenaUserInfo& info2);
+};
+
+}
+
+#endif
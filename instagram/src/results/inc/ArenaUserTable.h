@@ -0,0 +1,53 @@
+#ifndef ARENA_USER_TABLE_H
+#define ARENA_USER_TABLE_H
+
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+#include "ArenaUserInfo.h"
+
+namespace Instagram{
+
+// Immutable user shared by the arena media and comments it is the author of.
+using ArenaUserHandle = std::shared_ptr<const ArenaUserInfo>;
+
+// A handle to a copy of userInfo on the heap.
+EXPORT_INSTAGRAM ArenaUserHandle makeUserHandle(const ArenaUserInfo& userInfo);
+EXPORT_INSTAGRAM ArenaUserHandle makeUserHandle(ArenaUserInfo&& userInfo);
+
+// A handle to a copy of userInfo allocated in arena, or on the heap without
+// one. The handle keeps the arena alive, it may outlive the page.
+EXPORT_INSTAGRAM ArenaUserHandle makeUserHandle(ArenaUserInfo&& userInfo, const PageArena& arena);
+
+// userInfo for a result using allocator. Users on the heap or already using
+// allocator are shared, the others are copied to the heap so that a result
+// copied out of a page does not keep the page's arena alive.
+EXPORT_INSTAGRAM ArenaUserHandle shareUserHandle(const ArenaUserHandle& userInfo, const ResultAllocator& allocator);
+
+// Interns the authors of a page while it is parsed: every user id is stored
+// once, in the page's arena, and handed to all results by that user. Users
+// without an id are not shared. Tables made with just an allocator bind
+// results with it but keep their users on the heap.
+class EXPORT_INSTAGRAM ArenaUserTable{
+public:
+    using allocator_type = ResultAllocator;
+
+    explicit ArenaUserTable(const ResultAllocator& allocator = {});
+    explicit ArenaUserTable(PageArena arena);
+    ArenaUserTable(const ArenaUserTable&) = delete;
+    ArenaUserTable& operator=(const ArenaUserTable&) = delete;
+
+    ArenaUserHandle intern(ArenaUserInfo&& userInfo);
+    // shares the user already interned under the same id, if any
+    ArenaUserHandle intern(const ArenaUserHandle& userInfo);
+
+    ResultAllocator get_allocator() const noexcept;
+private:
+    PageArena m_arena{};
+    ResultAllocator m_allocator;
+    // keys point into the interned users' ids
+    std::unordered_map<std::string_view, ArenaUserHandle> m_users{};
+};
+
+}
+#endif
@@ -0,0 +1,16 @@
+#ifndef ARENA_USERS_INFO_H
+#define ARENA_USERS_INFO_H
+
+#include "ResultCollection.hpp"
+#include "ArenaUserInfo.h"
+
+namespace Instagram{
+
+using ArenaUsersInfo = ResultCollection<ArenaUserInfo>;
+
+#ifdef WIN32
+INSTAGRAM_EXP_TMP template class EXPORT_INSTAGRAM ResultCollection<ArenaUserInfo>;
+#endif
+
+}
+#endif
@@ -19,6 +19,7 @@ public:
     const UserInfo& userInfo() const noexcept;
 
     void setAuthToken(const std::string& token);
+    void setAuthToken(std::string&& token);
     void setUserInfo(const UserInfo& userInfo);
     void setUserInfo(UserInfo&& userInfo);
 private:
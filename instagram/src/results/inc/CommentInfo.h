@@ -3,6 +3,7 @@
 
 #include "BaseResult.h"
 #include "UserInfo.h"
+#include "UserTable.h"
 
 namespace Instagram{
 
@@ -24,17 +25,22 @@ public:
     const std::string& id() const noexcept;
     long createTime() const noexcept;
     const UserInfo& userInfo() const noexcept;
+    // shared with the other results of its page by the same user
+    const UserHandle& sharedUserInfo() const noexcept;
 
     void setText(const std::string &text);
+    void setText(std::string&& text);
     void setId(const std::string &id_);
+    void setId(std::string&& id_);
     void setCreateTime(long createdTime);
     void setUserInfo(const UserInfo& userInfo);
     void setUserInfo(UserInfo&& userInfo);
+    void setUserInfo(UserHandle userInfo);
 private:
     std::string m_text{""};
     std::string m_id {""};
     long m_createTime = -1;
-    UserInfo m_userInfo{};
+    UserHandle m_userInfo{};
 
     friend void swap(CommentInfo& first, CommentInfo& second);
 };
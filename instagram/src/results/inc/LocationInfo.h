@@ -22,7 +22,9 @@ public:
     double longitude() const;
 
     void setId(const std::string &id);
+    void setId(std::string&& id);
     void setName(const std::string &name);
+    void setName(std::string&& name);
     void setLatitude(double lat);
     void setLongitude(double lng);
 private:
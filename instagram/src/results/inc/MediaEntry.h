@@ -4,6 +4,7 @@
 #include <vector>
 #include <string>
 #include "UserInfo.h"
+#include "UserTable.h"
 //TODO: make this class iterable
 
 namespace Instagram{
@@ -41,6 +42,8 @@ public:
     const std::vector<std::string>& usersInPhoto() const noexcept;
 
     const UserInfo& userInfo() const noexcept;
+    // shared with the other results of its page by the same user
+    const UserHandle& sharedUserInfo() const noexcept;
 
     int commentsCount() const noexcept;
     int likesCount() const noexcept;
@@ -48,25 +51,37 @@ public:
 
     void setType(MediaType type);
     void setLink(const std::string& link);
+    void setLink(std::string&& link);
     void setId(const std::string& id);
+    void setId(std::string&& id);
     void setCaption(const std::string& caption);
+    void setCaption(std::string&& caption);
     void setStandartResolution(const std::string& url);
+    void setStandartResolution(std::string&& url);
     void setThumbnail(const std::string& url);
+    void setThumbnail(std::string&& url);
     void setLowResolution(const std::string& url);
+    void setLowResolution(std::string&& url);
     void setFilter(const std::string& filter);
+    void setFilter(std::string&& filter);
 
     void setVideoLowResolution(const std::string& url);
+    void setVideoLowResolution(std::string&& url);
     void setVideoStandartResolution(const std::string& url);
+    void setVideoStandartResolution(std::string&& url);
 
     void setCommentsCount(int count);
     void setLikeCount(int count);
     void setCreateTime(long time);
 
     void addTag(const std::string& tag);
+    void addTag(std::string&& tag);
     void addUser(const std::string& userId);
+    void addUser(std::string&& userId);
 
     void setUserInfo(const UserInfo& userInfo);
     void setUserInfo(UserInfo&& userInfo);
+    void setUserInfo(UserHandle userInfo);
 private:
     std::string m_link{};
     std::string m_id{};
@@ -82,7 +97,7 @@ private:
     std::vector<std::string> m_tags;
     std::vector<std::string> m_users;
 
-    UserInfo m_userInfo{};
+    UserHandle m_userInfo{};
 
     int m_commentsCount = -1;
     int m_likesCount = -1;
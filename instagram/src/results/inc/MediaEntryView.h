@@ -0,0 +1,84 @@
+#ifndef MEDIA_ENTRY_VIEW_H
+#define MEDIA_ENTRY_VIEW_H
+
+#include <string_view>
+#include <vector>
+#include "MediaEntry.h"
+#include "UserInfoView.h"
+
+namespace Instagram{
+#ifdef WIN32
+INSTAGRAM_EXP_TMP template class EXPORT_INSTAGRAM std::vector<std::string_view>;
+#endif
+
+// Read only counterpart of MediaEntry, its strings point into the response
+// of the page it was parsed with and are never copied. Valid as long as a
+// copy of that page is around.
+class EXPORT_INSTAGRAM MediaEntryView{
+public:
+    MediaType type() const noexcept;
+    std::string_view link() const noexcept;
+    std::string_view id() const noexcept;
+    std::string_view caption() const noexcept;
+    std::string_view standartResolution() const noexcept;
+    std::string_view thumbnail() const noexcept;
+    std::string_view lowResolution() const noexcept;
+    std::string_view filter() const noexcept;
+
+    std::string_view videoLowResolution() const noexcept;
+    std::string_view videoStandartResolution() const noexcept;
+
+    const std::vector<std::string_view>& tags() const noexcept;
+    const std::vector<std::string_view>& usersInPhoto() const noexcept;
+
+    const UserInfoView& userInfo() const noexcept;
+
+    int commentsCount() const noexcept;
+    int likesCount() const noexcept;
+    long createTime() const noexcept;
+
+    void setType(MediaType type);
+    void setLink(std::string_view link);
+    void setId(std::string_view id);
+    void setCaption(std::string_view caption);
+    void setStandartResolution(std::string_view url);
+    void setThumbnail(std::string_view url);
+    void setLowResolution(std::string_view url);
+    void setFilter(std::string_view filter);
+
+    void setVideoLowResolution(std::string_view url);
+    void setVideoStandartResolution(std::string_view url);
+
+    void setCommentsCount(int count);
+    void setLikeCount(int count);
+    void setCreateTime(long time);
+
+    void addTag(std::string_view tag);
+    void addUser(std::string_view userId);
+
+    void setUserInfo(const UserInfoView& userInfo);
+private:
+    std::string_view m_link{};
+    std::string_view m_id{};
+    std::string_view m_caption{};
+    std::string_view m_lowResolution{};
+    std::string_view m_thumbnail{};
+    std::string_view m_standartResolution{};
+    std::string_view m_filter{};
+
+    std::string_view m_videoLow{};
+    std::string_view m_videoStandart{};
+
+    std::vector<std::string_view> m_tags{};
+    std::vector<std::string_view> m_users{};
+
+    UserInfoView m_userInfo{};
+
+    int m_commentsCount = -1;
+    int m_likesCount = -1;
+    long m_createTime = -1;
+    MediaType m_mediaType = MediaType::UNKNOWN;
+};
+
+}
+#endif
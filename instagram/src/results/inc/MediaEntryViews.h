@@ -0,0 +1,17 @@
+#ifndef MEDIA_ENTRY_VIEWS_H
+#define MEDIA_ENTRY_VIEWS_H
+
+#include "ResultCollection.hpp"
+#include "MediaEntryView.h"
+
+namespace Instagram{
+
+using MediaEntryViews = ResultCollection<MediaEntryView>;
+
+#ifdef WIN32
+INSTAGRAM_EXP_TMP template class EXPORT_INSTAGRAM ResultCollection<MediaEntryView>;
+#endif
+
+}
+
+#endif
@@ -17,11 +17,16 @@ public:
 
     ~RelationshipInfo();
 
+    RelationshipInfo& operator=(const RelationshipInfo& relInfo);
+    RelationshipInfo& operator=(RelationshipInfo&& relInfo);
+
     const std::string& incomingStatus() const noexcept;
     const std::string& outgoingStatus() const noexcept;
 
     void setIncomingStatus(const std::string& status);
+    void setIncomingStatus(std::string&& status);
     void setOutgoingStatus(const std::string& status);
+    void setOutgoingStatus(std::string&& status);
 private:
     std::string m_incomingStatus{};
     std::string m_outgoingStatus{};
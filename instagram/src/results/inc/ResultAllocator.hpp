@@ -0,0 +1,85 @@
+#ifndef RESULT_ALLOCATOR_HPP
+#define RESULT_ALLOCATOR_HPP
+
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+
+namespace Instagram{
+
+// The arena results, ArenaUserInfo, ArenaMediaEntry and the others, allocate
+// their strings with it, from the heap unless they are created for a page
+// with an arena.
+using ResultAllocator = std::pmr::polymorphic_allocator<char>;
+
+// Memory a page and everything in it is allocated from, kept alive by the
+// page and released in one go with it.
+using PageArena = std::shared_ptr<std::pmr::memory_resource>;
+
+constexpr size_t PAGE_ARENA_SIZE = 64 * 1024;
+
+inline PageArena makePageArena(size_t initialSize = PAGE_ARENA_SIZE){
+    return std::make_shared<std::pmr::monotonic_buffer_resource>(initialSize);
+}
+
+// Allocator of the elements of a page. Unlike polymorphic_allocator it moves
+// along with the elements on move assignment, a page moved into another one
+// keeps its arena instead of being copied out of it. Copies of a page are
+// made on the heap.
+template<typename T>
+class PageAllocator{
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    PageAllocator() noexcept : m_resource{std::pmr::get_default_resource()} {}
+    PageAllocator(std::pmr::memory_resource* resource) noexcept : m_resource{resource} {}
+
+    template<typename U>
+    PageAllocator(const PageAllocator<U>& allocator) noexcept : m_resource{allocator.resource()} {}
+
+    T* allocate(size_t n){
+        return static_cast<T*>(m_resource->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* p, size_t n) noexcept{
+        m_resource->deallocate(p, n * sizeof(T), alignof(T));
+    }
+
+    // elements taking an allocator are constructed with the page's memory
+    template<typename U, typename... Args>
+    void construct(U* p, Args&&... args){
+        std::pmr::polymorphic_allocator<U>{m_resource}.construct(p, std::forward<Args>(args)...);
+    }
+
+    PageAllocator select_on_container_copy_construction() const noexcept{
+        return PageAllocator{};
+    }
+
+    std::pmr::memory_resource* resource() const noexcept{
+        return m_resource;
+    }
+
+    operator ResultAllocator() const noexcept{
+        return ResultAllocator{m_resource};
+    }
+private:
+    std::pmr::memory_resource* m_resource;
+};
+
+template<typename T, typename U>
+bool operator==(const PageAllocator<T>& first, const PageAllocator<U>& second) noexcept{
+    return *first.resource() == *second.resource();
+}
+
+template<typename T, typename U>
+bool operator!=(const PageAllocator<T>& first, const PageAllocator<U>& second) noexcept{
+    return !(first == second);
+}
+
+}
+
+#endif
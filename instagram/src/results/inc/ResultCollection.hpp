@@ -1,21 +1,47 @@
 #ifndef RESULT_COLLECTION_HPP
 #define RESULT_COLLECTION_HPP
 
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
 #include <vector>
+#include "ArenaUserTable.h"
 #include "BaseResult.h"
+#include "ResultAllocator.hpp"
+#include "UserTable.h"
 
 namespace Instagram{
     
+// Pages of arena results are created with an arena and allocate their
+// elements, and the elements' strings, from it. Moving such a page moves the
+// arena along, copying it copies the elements and their authors to the heap,
+// one author per user id as in the page. Pages of views
+// instead keep the source their elements point into, shared between copies.
 template<typename T>
 class ResultCollection : public BaseResult
 {
 public:
-    using iterator = typename std::vector<T>::iterator;
-    using const_iterator = typename std::vector<T>::const_iterator;
+    using allocator_type = std::conditional_t<std::uses_allocator<T, ResultAllocator>::value, PageAllocator<T>, std::allocator<T>>;
+    using container_type = std::vector<T, allocator_type>;
+    using iterator = typename container_type::iterator;
+    using const_iterator = typename container_type::const_iterator;
+    using value_type = T;
 
     ResultCollection() : BaseResult{}, m_elements(0){}
-    ResultCollection(const ResultCollection<T>& resultCollection) : BaseResult{resultCollection}, m_elements{resultCollection.m_elements}{}
-    ResultCollection(ResultCollection<T>&& resultCollection) : BaseResult{resultCollection}, m_elements{std::move(resultCollection.m_elements)}{}
+    template<typename U = T, typename = std::enable_if_t<std::uses_allocator<U, ResultAllocator>::value>>
+    explicit ResultCollection(PageArena arena) : BaseResult{}, m_arena{std::move(arena)},
+                                                 m_elements(allocator_type{m_arena ? m_arena.get() : std::pmr::get_default_resource()}){}
+    explicit ResultCollection(std::shared_ptr<const void> source) : BaseResult{}, m_source{std::move(source)}, m_elements(0){}
+    ResultCollection(const ResultCollection<T>& resultCollection) : BaseResult{resultCollection}, m_source{resultCollection.m_source},
+                                                                    m_elements{resultCollection.m_elements},
+                                                                    m_nextUrl{resultCollection.m_nextUrl}, m_nextMaxId{resultCollection.m_nextMaxId}{
+        shareAuthors(resultCollection);
+    }
+    ResultCollection(ResultCollection<T>&& resultCollection) : BaseResult{std::move(resultCollection)}, m_arena{std::move(resultCollection.m_arena)},
+                                                               m_source{std::move(resultCollection.m_source)},
+                                                               m_elements{std::move(resultCollection.m_elements)},
+                                                               m_nextUrl{std::move(resultCollection.m_nextUrl)}, m_nextMaxId{std::move(resultCollection.m_nextMaxId)}{}
     ResultCollection(const char* errMsg) : BaseResult{errMsg}, m_elements(0){}
     ResultCollection(const std::string& errMsg) : BaseResult{errMsg}, m_elements(0){}
     
@@ -26,6 +52,10 @@ public:
         
         BaseResult::operator=(resultCollection);
         m_elements = resultCollection.m_elements;
+        shareAuthors(resultCollection);
+        m_source = resultCollection.m_source;
+        m_nextUrl = resultCollection.m_nextUrl;
+        m_nextMaxId = resultCollection.m_nextMaxId;
         
         return *this;
     }
@@ -35,8 +65,13 @@ public:
             return *this;
         }
         
-        BaseResult::operator=(resultCollection);
-        m_elements = resultCollection.m_elements;
+        BaseResult::operator=(std::move(resultCollection));
+        // the old elements have to go before the arena they live in
+        m_elements = std::move(resultCollection.m_elements);
+        m_arena = std::move(resultCollection.m_arena);
+        m_source = std::move(resultCollection.m_source);
+        m_nextUrl = std::move(resultCollection.m_nextUrl);
+        m_nextMaxId = std::move(resultCollection.m_nextMaxId);
         
         return *this;
     }
@@ -57,9 +92,18 @@ public:
         return m_elements.end();
     }
     
-    const std::vector<T>& elements() const noexcept{
+    const container_type& elements() const noexcept{
         return m_elements;
     }
+
+    allocator_type get_allocator() const noexcept{
+        return m_elements.get_allocator();
+    }
+
+    // empty for pages on the heap and pages of results without an allocator
+    const PageArena& arena() const noexcept{
+        return m_arena;
+    }
     
     const T& get(size_t n) const {
         return m_elements[n];
@@ -93,9 +137,58 @@ public:
     void clear(){
         m_elements.clear();
     }
+
+    // Cursor of the following page as reported in the pagination object, empty
+    // on the last page.
+    const std::string& nextUrl() const noexcept{
+        return m_nextUrl;
+    }
+
+    void setNextUrl(const std::string& nextUrl){
+        m_nextUrl = nextUrl;
+    }
+
+    void setNextUrl(std::string&& nextUrl){
+        m_nextUrl = std::move(nextUrl);
+    }
+
+    const std::string& nextMaxId() const noexcept{
+        return m_nextMaxId;
+    }
+
+    void setNextMaxId(const std::string& nextMaxId){
+        m_nextMaxId = nextMaxId;
+    }
+
+    void setNextMaxId(std::string&& nextMaxId){
+        m_nextMaxId = std::move(nextMaxId);
+    }
+
+    bool hasNextPage() const noexcept{
+        return !m_nextUrl.empty();
+    }
     
 private:
-    std::vector<T> m_elements;
+    // Elements copied from another allocator each got their own copy of
+    // their author, the ones by the same user share one again.
+    void shareAuthors(const ResultCollection<T>& source){
+        if constexpr (HasAuthor<T>::value && std::uses_allocator<T, ResultAllocator>::value){
+            if(source.get_allocator() == get_allocator()){
+                return;
+            }
+
+            ArenaUserTable users{};
+            for(T& element : m_elements){
+                element.setUserInfo(users.intern(element.sharedUserInfo()));
+            }
+        }
+    }
+
+    PageArena m_arena{};
+    std::shared_ptr<const void> m_source{};
+    container_type m_elements;
+    std::string m_nextUrl{};
+    std::string m_nextMaxId{};
 };
 
 }
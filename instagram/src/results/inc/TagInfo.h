@@ -23,6 +23,7 @@ public:
     int count() const noexcept;
 
     void setName(const std::string& name);
+    void setName(std::string&& name);
     void setCount(int count);
 private:
     std::string m_name{};
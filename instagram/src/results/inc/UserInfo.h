@@ -31,11 +31,17 @@ public:
     int mediaCount() const noexcept;
 
     void setId(const std::string& id);
+    void setId(std::string&& id);
     void setUsername(const std::string& username);
+    void setUsername(std::string&& username);
     void setFullName(const std::string& name);
+    void setFullName(std::string&& name);
     void setBio(const std::string& bio);
+    void setBio(std::string&& bio);
     void setProfilePictureUrl(const std::string& profPicUrl);
+    void setProfilePictureUrl(std::string&& profPicUrl);
     void setWebsite(const std::string& website);
+    void setWebsite(std::string&& website);
 
     void setFollowedBy(int count);
     void setFollows(int count);
@@ -0,0 +1,49 @@
+#ifndef USER_INFO_VIEW_H
+#define USER_INFO_VIEW_H
+
+#include <string_view>
+#include "InstagramDefinitions.h"
+
+namespace Instagram{
+
+// Read only user whose strings point into the response of the page it was
+// parsed with, valid as long as a copy of that page is around.
+class EXPORT_INSTAGRAM UserInfoView{
+public:
+    std::string_view id() const noexcept;
+    std::string_view username() const noexcept;
+    std::string_view fullName() const noexcept;
+    std::string_view bio() const noexcept;
+    std::string_view profilePictureUrl() const noexcept;
+    std::string_view website() const noexcept;
+
+    int followedBy() const noexcept;
+    int follows() const noexcept;
+    int mediaCount() const noexcept;
+
+    void setId(std::string_view id);
+    void setUsername(std::string_view username);
+    void setFullName(std::string_view name);
+    void setBio(std::string_view bio);
+    void setProfilePictureUrl(std::string_view profPicUrl);
+    void setWebsite(std::string_view website);
+
+    void setFollowedBy(int count);
+    void setFollows(int count);
+    void setMediaCount(int count);
+private:
+    std::string_view m_id{};
+    std::string_view m_username{};
+    std::string_view m_fullName{};
+    std::string_view m_bio{};
+    std::string_view m_profPicUrl{};
+    std::string_view m_website{};
+
+    int m_followedBy{-1};
+    int m_follows{-1};
+    int m_mediaCount{-1};
+};
+
+}
+
+#endif
@@ -0,0 +1,16 @@
+#ifndef USER_INFO_VIEWS_H
+#define USER_INFO_VIEWS_H
+
+#include "UserInfoView.h"
+#include "ResultCollection.hpp"
+
+namespace Instagram{
+
+using UserInfoViews = ResultCollection<UserInfoView>;
+
+#ifdef WIN32
+INSTAGRAM_EXP_TMP template class EXPORT_INSTAGRAM ResultCollection<UserInfoView>;
+#endif
+
+}
+#endif
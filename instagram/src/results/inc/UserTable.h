@@ -0,0 +1,43 @@
+#ifndef USER_TABLE_H
+#define USER_TABLE_H
+
+#include <memory>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include "UserInfo.h"
+
+namespace Instagram{
+
+// Immutable user shared by the media and comments it is the author of.
+using UserHandle = std::shared_ptr<const UserInfo>;
+
+EXPORT_INSTAGRAM UserHandle makeUserHandle(const UserInfo& userInfo);
+EXPORT_INSTAGRAM UserHandle makeUserHandle(UserInfo&& userInfo);
+
+// Interns the authors of a page while it is parsed: every user id is stored
+// once and handed to all results by that user. Users without an id are not
+// shared.
+class EXPORT_INSTAGRAM UserTable{
+public:
+    UserTable() = default;
+    UserTable(const UserTable&) = delete;
+    UserTable& operator=(const UserTable&) = delete;
+
+    UserHandle intern(UserInfo&& userInfo);
+    // shares the user already interned under the same id, if any
+    UserHandle intern(const UserHandle& userInfo);
+private:
+    // keys point into the interned users' ids
+    std::unordered_map<std::string_view, UserHandle> m_users{};
+};
+
+template<typename Result, typename = void>
+struct HasAuthor : std::false_type {};
+
+template<typename Result>
+struct HasAuthor<Result, std::void_t<decltype(std::declval<const Result&>().sharedUserInfo())>> : std::true_type {};
+
+}
+#endif
@@ -0,0 +1,106 @@
+#include "ArenaCommentInfo.h"
+
+namespace Instagram {
+
+ArenaCommentInfo::ArenaCommentInfo() : ArenaCommentInfo(allocator_type{}) {}
+
+ArenaCommentInfo::ArenaCommentInfo(const allocator_type& allocator) : BaseResult{}, m_text{allocator}, m_id{allocator} {}
+
+ArenaCommentInfo::ArenaCommentInfo(std::string_view text, std::string_view id, long createTime, const ArenaUserInfo& userInfo) : BaseResult{}, m_text{text}, m_id{id}, m_createTime{createTime}, m_userInfo{makeUserHandle(userInfo)} {}
+
+ArenaCommentInfo::ArenaCommentInfo(const ArenaCommentInfo& commentInfo) : ArenaCommentInfo(commentInfo, allocator_type{}) {}
+
+ArenaCommentInfo::ArenaCommentInfo(const ArenaCommentInfo& commentInfo, const allocator_type& allocator) : BaseResult{commentInfo}, m_text{commentInfo.m_text, allocator}, m_id{commentInfo.m_id, allocator},
+                                                                                             m_createTime{commentInfo.m_createTime}, m_userInfo{shareUserHandle(commentInfo.m_userInfo, allocator)} {}
+
+ArenaCommentInfo::ArenaCommentInfo(ArenaCommentInfo&& commentInfo) : ArenaCommentInfo(std::move(commentInfo), allocator_type{}) {}
+
+ArenaCommentInfo::ArenaCommentInfo(ArenaCommentInfo&& commentInfo, const allocator_type& allocator) : ArenaCommentInfo(allocator){
+    *this = std::move(commentInfo);
+}
+
+ArenaCommentInfo::ArenaCommentInfo(const std::string& errMsg) : BaseResult{errMsg} {}
+
+ArenaCommentInfo::ArenaCommentInfo(const char* errMsg) : BaseResult{errMsg} {}
+
+ArenaCommentInfo::~ArenaCommentInfo() {}
+
+ArenaCommentInfo& ArenaCommentInfo::operator=(const ArenaCommentInfo& commentInfo) {
+    ArenaCommentInfo copy{commentInfo, get_allocator()};
+
+    swap(*this, copy);
+    return *this;
+}
+
+ArenaCommentInfo& ArenaCommentInfo::operator=(ArenaCommentInfo&& commentInfo) {
+    if (get_allocator() != commentInfo.get_allocator()) {
+        return *this = commentInfo;
+    }
+
+    swap(*this, commentInfo);
+
+    ArenaCommentInfo temp{commentInfo.get_allocator()};
+    swap(commentInfo, temp);
+    return *this;
+}
+
+ArenaCommentInfo::allocator_type ArenaCommentInfo::get_allocator() const noexcept {
+    return m_id.get_allocator();
+}
+
+std::string_view ArenaCommentInfo::text() const noexcept {
+    return m_text;
+}
+
+std::string_view ArenaCommentInfo::id() const noexcept {
+    return m_id;
+}
+
+long ArenaCommentInfo::createTime() const noexcept {
+    return m_createTime;
+}
+
+const ArenaUserInfo& ArenaCommentInfo::userInfo() const noexcept {
+    static const ArenaUserInfo none{};
+    return m_userInfo ? *m_userInfo : none;
+}
+
+const ArenaUserHandle& ArenaCommentInfo::sharedUserInfo() const noexcept {
+    return m_userInfo;
+}
+
+void ArenaCommentInfo::setText(std::string_view text) {
+    m_text = text;
+}
+
+void ArenaCommentInfo::setId(std::string_view id) {
+    m_id = id;
+}
+
+void ArenaCommentInfo::setCreateTime(long create_time_) {
+    m_createTime = create_time_;
+}
+
+void ArenaCommentInfo::setUserInfo(const ArenaUserInfo &userInfo) {
+    m_userInfo = makeUserHandle(userInfo);
+}
+
+void ArenaCommentInfo::setUserInfo(ArenaUserInfo&& userInfo){
+    m_userInfo = makeUserHandle(std::move(userInfo));
+}
+
+void ArenaCommentInfo::setUserInfo(ArenaUserHandle userInfo){
+    m_userInfo = std::move(userInfo);
+}
+
+void swap(ArenaCommentInfo& first, ArenaCommentInfo& second){
+    using std::swap;
+    swap(static_cast<BaseResult&>(first), static_cast<BaseResult&>(second));
+
+    swap(first.m_text, second.m_text);
+    swap(first.m_id, second.m_id);
+    swap(first.m_createTime, second.m_createTime);
+    swap(first.m_userInfo, second.m_userInfo);
+}
+
+}
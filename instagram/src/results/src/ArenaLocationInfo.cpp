@@ -0,0 +1,89 @@
+#include "ArenaLocationInfo.h"
+
+namespace Instagram {
+
+ArenaLocationInfo::ArenaLocationInfo() : ArenaLocationInfo(allocator_type{}) {}
+
+ArenaLocationInfo::ArenaLocationInfo(const allocator_type& allocator) : BaseResult{}, m_id{allocator}, m_name{allocator} {}
+
+ArenaLocationInfo::ArenaLocationInfo(const ArenaLocationInfo& locInfo) : ArenaLocationInfo(locInfo, allocator_type{}) {}
+
+ArenaLocationInfo::ArenaLocationInfo(const ArenaLocationInfo& locInfo, const allocator_type& allocator) : BaseResult{locInfo}, m_id{locInfo.m_id, allocator}, m_name{locInfo.m_name, allocator},
+                                                                                            m_lat{locInfo.m_lat}, m_lng{locInfo.m_lng} {}
+
+ArenaLocationInfo::ArenaLocationInfo(ArenaLocationInfo&& locInfo) : ArenaLocationInfo(std::move(locInfo), allocator_type{}) {}
+
+ArenaLocationInfo::ArenaLocationInfo(ArenaLocationInfo&& locInfo, const allocator_type& allocator) : ArenaLocationInfo(allocator){
+    *this = std::move(locInfo);
+}
+
+ArenaLocationInfo::ArenaLocationInfo(const std::string& errMsg) : BaseResult{errMsg} {}
+
+ArenaLocationInfo::ArenaLocationInfo(const char* errMsg) : BaseResult{errMsg} {}
+
+ArenaLocationInfo& ArenaLocationInfo::operator=(const ArenaLocationInfo& locInfo) {
+    ArenaLocationInfo copy{locInfo, get_allocator()};
+
+    swap(*this, copy);
+    return *this;
+}
+
+ArenaLocationInfo& ArenaLocationInfo::operator=(ArenaLocationInfo&& locInfo) {
+    if (get_allocator() != locInfo.get_allocator()) {
+        return *this = locInfo;
+    }
+
+    swap(*this, locInfo);
+
+    ArenaLocationInfo temp{locInfo.get_allocator()};
+    swap(locInfo, temp);
+    return *this;
+}
+
+ArenaLocationInfo::allocator_type ArenaLocationInfo::get_allocator() const noexcept {
+    return m_id.get_allocator();
+}
+
+std::string_view ArenaLocationInfo::id() const {
+    return m_id;
+}
+
+std::string_view ArenaLocationInfo::name() const {
+    return m_name;
+}
+
+double ArenaLocationInfo::latitude() const {
+    return m_lat;
+}
+
+double ArenaLocationInfo::longitude() const {
+    return m_lng;
+}
+
+void ArenaLocationInfo::setId(std::string_view id) {
+    m_id = id;
+}
+
+void ArenaLocationInfo::setName(std::string_view name) {
+    m_name = name;
+}
+
+void ArenaLocationInfo::setLatitude(double lat) {
+    m_lat = lat;
+}
+
+void ArenaLocationInfo::setLongitude(double lng) {
+    m_lng = lng;
+}
+
+void swap(ArenaLocationInfo& first, ArenaLocationInfo& second){
+    using std::swap;
+    swap(static_cast<BaseResult&>(first), static_cast<BaseResult&>(second));
+
+    swap(first.m_id, second.m_id);
+    swap(first.m_name, second.m_name);
+    swap(first.m_lat, second.m_lat);
+    swap(first.m_lng, second.m_lng);
+}
+
+}
@@ -0,0 +1,243 @@
+#include "ArenaMediaEntry.h"
+
+namespace Instagram {
+
+ArenaMediaEntry::ArenaMediaEntry() : ArenaMediaEntry(allocator_type{}) {}
+
+ArenaMediaEntry::ArenaMediaEntry(const allocator_type& allocator) : BaseResult{},
+                                                          m_link{allocator},
+                                                          m_id{allocator},
+                                                          m_caption{allocator},
+                                                          m_lowResolution{allocator},
+                                                          m_thumbnail{allocator},
+                                                          m_standartResolution{allocator},
+                                                          m_filter{allocator},
+                                                          m_videoLow{allocator},
+                                                          m_videoStandart{allocator},
+                                                          m_tags{allocator},
+                                                          m_users{allocator} {}
+
+ArenaMediaEntry::ArenaMediaEntry(const std::string& errMsg) : BaseResult{errMsg} {}
+
+ArenaMediaEntry::ArenaMediaEntry(const char* errMsg) : BaseResult{errMsg} {}
+
+ArenaMediaEntry::ArenaMediaEntry(const ArenaMediaEntry &mediaEntry) : ArenaMediaEntry(mediaEntry, allocator_type{}) {}
+
+ArenaMediaEntry::ArenaMediaEntry(const ArenaMediaEntry &mediaEntry, const allocator_type& allocator): BaseResult{mediaEntry},
+                                                        m_link{mediaEntry.m_link, allocator},
+                                                        m_id{mediaEntry.m_id, allocator},
+                                                        m_caption{mediaEntry.m_caption, allocator},
+                                                        m_lowResolution{mediaEntry.m_lowResolution, allocator},
+                                                        m_thumbnail{mediaEntry.m_thumbnail, allocator},
+                                                        m_standartResolution{mediaEntry.m_standartResolution, allocator},
+                                                        m_filter{mediaEntry.m_filter, allocator},
+                                                        m_videoLow{mediaEntry.m_videoLow, allocator},
+                                                        m_videoStandart{mediaEntry.m_videoStandart, allocator},
+                                                        m_tags{mediaEntry.m_tags, allocator},
+                                                        m_users{mediaEntry.m_users, allocator},
+                                                        m_userInfo{shareUserHandle(mediaEntry.m_userInfo, allocator)},
+                                                        m_commentsCount{mediaEntry.m_commentsCount},
+                                                        m_likesCount{mediaEntry.m_likesCount},
+                                                        m_createTime{mediaEntry.m_createTime},
+                                                        m_mediaType{mediaEntry.m_mediaType} {}
+
+
+// lands on the heap, an entry moved out of a page must not depend on its arena
+ArenaMediaEntry::ArenaMediaEntry(ArenaMediaEntry &&mediaEntry) : ArenaMediaEntry(std::move(mediaEntry), allocator_type{}) {}
+
+ArenaMediaEntry::ArenaMediaEntry(ArenaMediaEntry &&mediaEntry, const allocator_type& allocator) : ArenaMediaEntry(allocator){
+    *this = std::move(mediaEntry);
+}
+
+ArenaMediaEntry::~ArenaMediaEntry() {}
+
+ArenaMediaEntry& ArenaMediaEntry::operator=(const ArenaMediaEntry& mediaEntry) {
+    ArenaMediaEntry copy{mediaEntry, get_allocator()};
+
+    swap(*this, copy);
+    return *this;
+}
+
+// entries in different arenas can not trade their strings, they are copied
+ArenaMediaEntry& ArenaMediaEntry::operator=(ArenaMediaEntry&& mediaEntry) {
+    if (get_allocator() != mediaEntry.get_allocator()) {
+        return *this = mediaEntry;
+    }
+
+    swap(*this, mediaEntry);
+
+    ArenaMediaEntry temp{mediaEntry.get_allocator()};
+    swap(mediaEntry, temp);
+
+    return *this;
+}
+
+ArenaMediaEntry::allocator_type ArenaMediaEntry::get_allocator() const noexcept {
+    return m_id.get_allocator();
+}
+
+MediaType ArenaMediaEntry::type() const noexcept {
+    return m_mediaType;
+}
+
+std::string_view ArenaMediaEntry::link() const noexcept {
+    return m_link;
+}
+
+std::string_view ArenaMediaEntry::id() const noexcept {
+    return m_id;
+}
+
+std::string_view ArenaMediaEntry::caption() const noexcept {
+    return m_caption;
+}
+
+const std::pmr::vector<std::pmr::string>& ArenaMediaEntry::tags() const noexcept {
+    return m_tags;
+}
+
+const std::pmr::vector<std::pmr::string>& ArenaMediaEntry::usersInPhoto() const noexcept {
+    return m_users;
+}
+
+int ArenaMediaEntry::commentsCount() const  noexcept {
+    return m_commentsCount;
+}
+
+int ArenaMediaEntry::likesCount() const noexcept {
+    return m_likesCount;
+}
+
+long ArenaMediaEntry::createTime() const noexcept {
+    return m_createTime;
+}
+
+std::string_view ArenaMediaEntry::standartResolution() const noexcept {
+    return m_standartResolution;
+}
+
+std::string_view ArenaMediaEntry::thumbnail() const noexcept {
+    return m_thumbnail;
+}
+
+std::string_view ArenaMediaEntry::lowResolution() const noexcept {
+    return m_lowResolution;
+}
+
+std::string_view ArenaMediaEntry::filter() const noexcept {
+    return m_filter;
+}
+
+std::string_view ArenaMediaEntry::videoLowResolution() const noexcept {
+    return m_videoLow;
+}
+
+std::string_view ArenaMediaEntry::videoStandartResolution() const noexcept {
+    return m_videoStandart;
+}
+
+const ArenaUserInfo& ArenaMediaEntry::userInfo() const noexcept{
+    static const ArenaUserInfo none{};
+    return m_userInfo ? *m_userInfo : none;
+}
+
+const ArenaUserHandle& ArenaMediaEntry::sharedUserInfo() const noexcept{
+    return m_userInfo;
+}
+
+void ArenaMediaEntry::setType(MediaType type) {
+    m_mediaType = type;
+}
+
+void ArenaMediaEntry::setLink(std::string_view _m_link) {
+    m_link = _m_link;
+}
+
+void ArenaMediaEntry::setId(std::string_view id) {
+    m_id = id;
+}
+
+void ArenaMediaEntry::setCaption(std::string_view caption) {
+    m_caption = caption;
+}
+
+void ArenaMediaEntry::addTag(std::string_view tag) {
+    m_tags.emplace_back(tag);
+}
+
+void ArenaMediaEntry::setCommentsCount(int count) {
+    m_commentsCount = count;
+}
+
+void ArenaMediaEntry::setLikeCount(int count) {
+    m_likesCount = count;
+}
+
+void ArenaMediaEntry::setCreateTime(long time) {
+    m_createTime = time;
+}
+
+void ArenaMediaEntry::setStandartResolution(std::string_view url) {
+    m_standartResolution = url;
+}
+
+void ArenaMediaEntry::setThumbnail(std::string_view url) {
+    m_thumbnail = url;
+}
+
+void ArenaMediaEntry::setLowResolution(std::string_view url) {
+    m_lowResolution = url;
+}
+
+void ArenaMediaEntry::setFilter(std::string_view _m_filter) {
+    m_filter = _m_filter;
+}
+
+void ArenaMediaEntry::setVideoLowResolution(std::string_view url) {
+    m_videoLow = url;
+}
+
+void ArenaMediaEntry::setVideoStandartResolution(std::string_view url) {
+    m_videoStandart = url;
+}
+
+void ArenaMediaEntry::addUser(std::string_view user) {
+    m_users.emplace_back(user);
+}
+
+void ArenaMediaEntry::setUserInfo(const ArenaUserInfo& userInfo){
+    m_userInfo = makeUserHandle(userInfo);
+}
+
+void ArenaMediaEntry::setUserInfo(ArenaUserInfo&& userInfo){
+    m_userInfo = makeUserHandle(std::move(userInfo));
+}
+
+void ArenaMediaEntry::setUserInfo(ArenaUserHandle userInfo){
+    m_userInfo = std::move(userInfo);
+}
+
+void swap(ArenaMediaEntry& media1, ArenaMediaEntry& media2){
+    using std::swap;
+
+    swap(static_cast<BaseResult&>(media1), static_cast<BaseResult&>(media2));
+
+    swap(media1.m_link, media2.m_link);
+    swap(media1.m_id, media2.m_id);
+    swap(media1.m_caption, media2.m_caption);
+    swap(media1.m_lowResolution, media2.m_lowResolution);
+    swap(media1.m_thumbnail, media2.m_thumbnail);
+    swap(media1.m_standartResolution, media2.m_standartResolution);
+    swap(media1.m_filter, media2.m_filter);
+    swap(media1.m_videoLow, media2.m_videoLow);
+    swap(media1.m_videoStandart, media2.m_videoStandart);
+    swap(media1.m_tags, media2.m_tags);
+    swap(media1.m_users, media2.m_users);
+    swap(media1.m_userInfo, media2.m_userInfo);
+    swap(media1.m_commentsCount, media2.m_commentsCount);
+    swap(media1.m_likesCount, media2.m_likesCount);
+    swap(media1.m_createTime, media2.m_createTime);
+    swap(media1.m_mediaType, media2.m_mediaType);
+}
+
+}
@@ -0,0 +1,74 @@
+#include"ArenaTagInfo.h"
+
+namespace Instagram {
+
+ArenaTagInfo::ArenaTagInfo() : ArenaTagInfo(allocator_type{}) {}
+
+ArenaTagInfo::ArenaTagInfo(const allocator_type& allocator) : BaseResult{}, m_name{allocator} {}
+
+ArenaTagInfo::ArenaTagInfo(const char* errMsg) : BaseResult{errMsg} {}
+
+ArenaTagInfo::ArenaTagInfo(const std::string& errMsg) : BaseResult{errMsg} {}
+
+ArenaTagInfo::ArenaTagInfo(std::string_view name, int count) : BaseResult{}, m_name{name}, m_count{count} {}
+
+ArenaTagInfo::ArenaTagInfo(const ArenaTagInfo& tagInfo) : ArenaTagInfo(tagInfo, allocator_type{}) {}
+
+ArenaTagInfo::ArenaTagInfo(const ArenaTagInfo& tagInfo, const allocator_type& allocator) : BaseResult{tagInfo}, m_name{tagInfo.m_name, allocator}, m_count{tagInfo.m_count} {}
+
+ArenaTagInfo::ArenaTagInfo(ArenaTagInfo&& tagInfo) : ArenaTagInfo(std::move(tagInfo), allocator_type{}) {}
+
+ArenaTagInfo::ArenaTagInfo(ArenaTagInfo&& tagInfo, const allocator_type& allocator) : ArenaTagInfo(allocator){
+    *this = std::move(tagInfo);
+}
+
+ArenaTagInfo::~ArenaTagInfo() {}
+
+ArenaTagInfo& ArenaTagInfo::operator=(const ArenaTagInfo& tagInfo) {
+    ArenaTagInfo copy{tagInfo, get_allocator()};
+
+    swap(*this, copy);
+    return *this;
+}
+
+ArenaTagInfo& ArenaTagInfo::operator=(ArenaTagInfo&& tagInfo) {
+    if (get_allocator() != tagInfo.get_allocator()) {
+        return *this = tagInfo;
+    }
+
+    swap(*this, tagInfo);
+
+    ArenaTagInfo temp{tagInfo.get_allocator()};
+    swap(tagInfo, temp);
+    return *this;
+}
+
+ArenaTagInfo::allocator_type ArenaTagInfo::get_allocator() const noexcept {
+    return m_name.get_allocator();
+}
+
+std::string_view ArenaTagInfo::name() const noexcept {
+    return m_name;
+}
+
+int ArenaTagInfo::count() const noexcept {
+    return m_count;
+}
+
+void ArenaTagInfo::setName(std::string_view name) {
+    m_name = name;
+}
+
+void ArenaTagInfo::setCount(int count) {
+    m_count = count;
+}
+
+void swap(ArenaTagInfo& first, ArenaTagInfo& second){
+    using std::swap;
+    swap(static_cast<BaseResult&>(first), static_cast<BaseResult&>(second));
+
+    swap(first.m_name, second.m_name);
+    swap(first.m_count, second.m_count);
+}
+
+}
@@ -0,0 +1,152 @@
+#include "ArenaUserInfo.h"
+
+namespace Instagram {
+
+ArenaUserInfo::ArenaUserInfo() : ArenaUserInfo(allocator_type{}) {}
+
+ArenaUserInfo::ArenaUserInfo(const allocator_type& allocator) : BaseResult{},
+                                                      m_id{allocator},
+                                                      m_username{allocator},
+                                                      m_fullName{allocator},
+                                                      m_bio{allocator},
+                                                      m_profPicUrl{allocator},
+                                                      m_website{allocator} {}
+
+ArenaUserInfo::ArenaUserInfo(const ArenaUserInfo& userInfo) : ArenaUserInfo(userInfo, allocator_type{}) {}
+
+ArenaUserInfo::ArenaUserInfo(const ArenaUserInfo& userInfo, const allocator_type& allocator) : BaseResult{userInfo},
+                                                                                m_id{userInfo.m_id, allocator},
+                                                                                m_username{userInfo.m_username, allocator},
+                                                                                m_fullName{userInfo.m_fullName, allocator},
+                                                                                m_bio{userInfo.m_bio, allocator},
+                                                                                m_profPicUrl{userInfo.m_profPicUrl, allocator},
+                                                                                m_website{userInfo.m_website, allocator},
+                                                                                m_followedBy{userInfo.m_followedBy},
+                                                                                m_follows{userInfo.m_follows},
+                                                                                m_mediaCount{userInfo.m_mediaCount} {}
+
+ArenaUserInfo::ArenaUserInfo(ArenaUserInfo&& userInfo) : ArenaUserInfo(std::move(userInfo), allocator_type{}) {}
+
+ArenaUserInfo::ArenaUserInfo(ArenaUserInfo&& userInfo, const allocator_type& allocator) : ArenaUserInfo(allocator){
+    *this = std::move(userInfo);
+}
+
+ArenaUserInfo::ArenaUserInfo(const char* errMsg) : BaseResult{errMsg} {}
+
+ArenaUserInfo::ArenaUserInfo(const std::string& errMsg) : BaseResult{errMsg} {}
+
+ArenaUserInfo::~ArenaUserInfo() {}
+
+ArenaUserInfo& ArenaUserInfo::operator=(const ArenaUserInfo& userInfo) {
+    ArenaUserInfo copy{userInfo, get_allocator()};
+
+    swap(*this, copy);
+    return *this;
+}
+
+// users in different arenas can not trade their strings, they are copied
+ArenaUserInfo& ArenaUserInfo::operator=(ArenaUserInfo&& userInfo) {
+    if (get_allocator() != userInfo.get_allocator()) {
+        return *this = userInfo;
+    }
+
+    swap(*this, userInfo);
+
+    ArenaUserInfo temp{userInfo.get_allocator()};
+    swap(userInfo, temp);
+    return *this;
+}
+
+ArenaUserInfo::allocator_type ArenaUserInfo::get_allocator() const noexcept {
+    return m_id.get_allocator();
+}
+
+std::string_view ArenaUserInfo::id() const noexcept {
+    return m_id;
+}
+
+std::string_view ArenaUserInfo::username() const noexcept {
+    return m_username;
+}
+
+
+std::string_view ArenaUserInfo::fullName() const noexcept {
+    return m_fullName;
+}
+
+std::string_view ArenaUserInfo::bio() const noexcept {
+    return m_bio;
+}
+
+std::string_view ArenaUserInfo::profilePictureUrl() const noexcept {
+    return m_profPicUrl;
+}
+
+std::string_view ArenaUserInfo::website() const noexcept {
+    return m_website;
+}
+
+int ArenaUserInfo::followedBy() const noexcept {
+    return m_followedBy;
+}
+
+int ArenaUserInfo::follows() const noexcept {
+    return m_follows;
+}
+
+int ArenaUserInfo::mediaCount() const noexcept {
+    return m_mediaCount;
+}
+
+void ArenaUserInfo::setId(std::string_view id) {
+    m_id = id;
+}
+
+void ArenaUserInfo::setUsername(std::string_view username) {
+    m_username = username;
+}
+
+void ArenaUserInfo::setFullName(std::string_view name) {
+    m_fullName = name;
+}
+
+void ArenaUserInfo::setBio(std::string_view bio) {
+    m_bio = bio;
+}
+
+void ArenaUserInfo::setProfilePictureUrl(std::string_view profPicUrl) {
+    m_profPicUrl = profPicUrl;
+}
+
+void ArenaUserInfo::setWebsite(std::string_view website) {
+    m_website = website;
+}
+
+void ArenaUserInfo::setFollowedBy(int count) {
+    m_followedBy = count;
+}
+
+void ArenaUserInfo::setFollows(int count) {
+    m_follows = count;
+}
+
+void ArenaUserInfo::setMediaCount(int count) {
+    m_mediaCount = count;
+}
+
+void swap(ArenaUserInfo& info1, ArenaUserInfo& info2){
+    using std::swap;
+    swap(static_cast<BaseResult&>(info1), static_cast<BaseResult&>(info2));
+
+    swap(info1.m_id, info2.m_id);
+    swap(info1.m_username, info2.m_username);
+    swap(info1.m_fullName, info2.m_fullName);
+    swap(info1.m_bio, info2.m_bio);
+    swap(info1.m_profPicUrl, info2.m_profPicUrl);
+    swap(info1.m_website, info2.m_website);
+    swap(info1.m_followedBy, info2.m_followedBy);
+    swap(info1.m_follows, info2.m_follows);
+    swap(info1.m_mediaCount, info2.m_mediaCount);
+}
+
+}
@@ -0,0 +1,106 @@
+#include "ArenaUserTable.h"
+
+namespace Instagram {
+
+namespace {
+
+// Allocates a user and its handle's control block from a page's arena. The
+// control block keeps its copy of the allocator, so the arena lives as long
+// as the last handle does.
+template<typename T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+
+    explicit ArenaAllocator(PageArena arena) noexcept : m_arena{std::move(arena)} {}
+
+    template<typename U>
+    ArenaAllocator(const ArenaAllocator<U>& allocator) noexcept : m_arena{allocator.arena()} {}
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(m_arena->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        m_arena->deallocate(p, n * sizeof(T), alignof(T));
+    }
+
+    // the user's strings go to the arena as well
+    template<typename U, typename... Args>
+    void construct(U* p, Args&&... args) {
+        std::pmr::polymorphic_allocator<U>{m_arena.get()}.construct(p, std::forward<Args>(args)...);
+    }
+
+    const PageArena& arena() const noexcept {
+        return m_arena;
+    }
+private:
+    PageArena m_arena;
+};
+
+template<typename T, typename U>
+bool operator==(const ArenaAllocator<T>& first, const ArenaAllocator<U>& second) noexcept {
+    return first.arena() == second.arena();
+}
+
+template<typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& first, const ArenaAllocator<U>& second) noexcept {
+    return !(first == second);
+}
+
+}
+
+ArenaUserHandle makeUserHandle(const ArenaUserInfo& userInfo) {
+    return std::make_shared<ArenaUserInfo>(userInfo);
+}
+
+ArenaUserHandle makeUserHandle(ArenaUserInfo&& userInfo) {
+    return std::make_shared<ArenaUserInfo>(std::move(userInfo));
+}
+
+ArenaUserHandle makeUserHandle(ArenaUserInfo&& userInfo, const PageArena& arena) {
+    if (!arena) {
+        return makeUserHandle(std::move(userInfo));
+    }
+    return std::allocate_shared<ArenaUserInfo>(ArenaAllocator<ArenaUserInfo>{arena}, std::move(userInfo));
+}
+
+ArenaUserHandle shareUserHandle(const ArenaUserHandle& userInfo, const ResultAllocator& allocator) {
+    if (!userInfo || userInfo->get_allocator() == allocator || userInfo->get_allocator() == ResultAllocator{}) {
+        return userInfo;
+    }
+    return makeUserHandle(*userInfo);
+}
+
+ArenaUserTable::ArenaUserTable(const ResultAllocator& allocator) : m_allocator{allocator} {}
+
+ArenaUserTable::ArenaUserTable(PageArena arena) : m_arena{std::move(arena)},
+                                        m_allocator{m_arena ? m_arena.get() : std::pmr::get_default_resource()} {}
+
+ArenaUserHandle ArenaUserTable::intern(ArenaUserInfo&& userInfo) {
+    if (userInfo.id().empty()) {
+        return makeUserHandle(std::move(userInfo), m_arena);
+    }
+
+    auto it = m_users.find(userInfo.id());
+    if (it != m_users.end()) {
+        return it->second;
+    }
+
+    ArenaUserHandle handle = makeUserHandle(std::move(userInfo), m_arena);
+    m_users.emplace(handle->id(), handle);
+    return handle;
+}
+
+ArenaUserHandle ArenaUserTable::intern(const ArenaUserHandle& userInfo) {
+    if (!userInfo || userInfo->id().empty()) {
+        return userInfo;
+    }
+    return m_users.emplace(userInfo->id(), userInfo).first->second;
+}
+
+ResultAllocator ArenaUserTable::get_allocator() const noexcept {
+    return m_allocator;
+}
+
+}
@@ -33,6 +33,10 @@ void AuthorizationToken::setAuthToken(const std::string& token){
     m_token = token;
 }
 
+void AuthorizationToken::setAuthToken(std::string&& token){
+    m_token = std::move(token);
+}
+
 void AuthorizationToken::setUserInfo(const UserInfo& userInfo){
     m_userInfo = userInfo;
 }
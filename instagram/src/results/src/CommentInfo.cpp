@@ -8,7 +8,7 @@ namespace Instagram {
 
 CommentInfo::CommentInfo() : BaseResult{} {}
 
-CommentInfo::CommentInfo(const std::string& text, const std::string& id, long createTime, const UserInfo& userInfo) : BaseResult{}, m_text{text}, m_id{id}, m_createTime{createTime}, m_userInfo{userInfo} {}
+CommentInfo::CommentInfo(const std::string& text, const std::string& id, long createTime, const UserInfo& userInfo) : BaseResult{}, m_text{text}, m_id{id}, m_createTime{createTime}, m_userInfo{makeUserHandle(userInfo)} {}
 
 CommentInfo::CommentInfo(const CommentInfo& commentInfo) : BaseResult{commentInfo}, m_text{commentInfo.m_text}, m_id{commentInfo.m_id}, m_createTime{commentInfo.m_createTime}, m_userInfo{commentInfo.m_userInfo} {}
 
@@ -50,6 +50,11 @@ long CommentInfo::createTime() const noexcept {
 }
 
 const UserInfo& CommentInfo::userInfo() const noexcept {
+    static const UserInfo none{};
+    return m_userInfo ? *m_userInfo : none;
+}
+
+const UserHandle& CommentInfo::sharedUserInfo() const noexcept {
     return m_userInfo;
 }
 
@@ -57,23 +62,32 @@ void CommentInfo::setText(const std::string &text) {
     m_text = text;
 }
 
+void CommentInfo::setText(std::string&& text) {
+    m_text = std::move(text);
+}
+
 void CommentInfo::setId(const std::string &id) {
     m_id = id;
 }
 
+void CommentInfo::setId(std::string&& id) {
+    m_id = std::move(id);
+}
+
 void CommentInfo::setCreateTime(long create_time_) {
     m_createTime = create_time_;
 }
 
-void CommentInfo::setUserInfo(const UserInfo &userInfo) {
-    m_userInfo = userInfo;
+void CommentInfo::setUserInfo(const UserInfo& userInfo) {
+    m_userInfo = makeUserHandle(userInfo);
 }
 
-void CommentInfo::setUserInfo(UserInfo&& userInfo){
-    swap(m_userInfo, userInfo);
+void CommentInfo::setUserInfo(UserInfo&& userInfo) {
+    m_userInfo = makeUserHandle(std::move(userInfo));
+}
 
-    UserInfo temp{};
-    swap(userInfo, temp);
+void CommentInfo::setUserInfo(UserHandle userInfo) {
+    m_userInfo = std::move(userInfo);
 }
 
 void swap(CommentInfo& first, CommentInfo& second){
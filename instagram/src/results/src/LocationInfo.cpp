@@ -49,10 +49,18 @@ void LocationInfo::setId(const std::string &id) {
     m_id = id;
 }
 
+void LocationInfo::setId(std::string&& id) {
+    m_id = std::move(id);
+}
+
 void LocationInfo::setName(const std::string &name) {
     m_name = name;
 }
 
+void LocationInfo::setName(std::string&& name) {
+    m_name = std::move(name);
+}
+
 void LocationInfo::setLatitude(double lat) {
     m_lat = lat;
 }
@@ -113,7 +113,12 @@ const std::string& MediaEntry::videoStandartResolution() const noexcept {
     return m_videoStandart;
 }
 
-const UserInfo& MediaEntry::userInfo() const noexcept{
+const UserInfo& MediaEntry::userInfo() const noexcept {
+    static const UserInfo none{};
+    return m_userInfo ? *m_userInfo : none;
+}
+
+const UserHandle& MediaEntry::sharedUserInfo() const noexcept {
     return m_userInfo;
 }
 
@@ -125,18 +130,34 @@ void MediaEntry::setLink(const std::string& _m_link) {
     m_link = _m_link;
 }
 
+void MediaEntry::setLink(std::string&& _m_link) {
+    m_link = std::move(_m_link);
+}
+
 void MediaEntry::setId(const std::string& id) {
     m_id = id;
 }
 
+void MediaEntry::setId(std::string&& id) {
+    m_id = std::move(id);
+}
+
 void MediaEntry::setCaption(const std::string& caption) {
     m_caption = caption;
 }
 
+void MediaEntry::setCaption(std::string&& caption) {
+    m_caption = std::move(caption);
+}
+
 void MediaEntry::addTag(const std::string &tag) {
     m_tags.push_back(tag);
 }
 
+void MediaEntry::addTag(std::string&& tag) {
+    m_tags.push_back(std::move(tag));
+}
+
 void MediaEntry::setCommentsCount(int count) {
     m_commentsCount = count;
 }
@@ -153,40 +174,68 @@ void MediaEntry::setStandartResolution(const std::string& url) {
     m_standartResolution = url;
 }
 
+void MediaEntry::setStandartResolution(std::string&& url) {
+    m_standartResolution = std::move(url);
+}
+
 void MediaEntry::setThumbnail(const std::string& url) {
     m_thumbnail = url;
 }
 
+void MediaEntry::setThumbnail(std::string&& url) {
+    m_thumbnail = std::move(url);
+}
+
 void MediaEntry::setLowResolution(const std::string& url) {
     m_lowResolution = url;
 }
 
+void MediaEntry::setLowResolution(std::string&& url) {
+    m_lowResolution = std::move(url);
+}
+
 void MediaEntry::setFilter(const std::string& _m_filter) {
     m_filter = _m_filter;
 }
 
+void MediaEntry::setFilter(std::string&& _m_filter) {
+    m_filter = std::move(_m_filter);
+}
+
 void MediaEntry::setVideoLowResolution(const std::string& url) {
     m_videoLow = url;
 }
 
+void MediaEntry::setVideoLowResolution(std::string&& url) {
+    m_videoLow = std::move(url);
+}
+
 void MediaEntry::setVideoStandartResolution(const std::string& url) {
     m_videoStandart = url;
 }
 
+void MediaEntry::setVideoStandartResolution(std::string&& url) {
+    m_videoStandart = std::move(url);
+}
+
 void MediaEntry::addUser(const std::string& user) {
     m_users.push_back(user);
 }
 
-void MediaEntry::setUserInfo(const UserInfo& userInfo){
-    m_userInfo = userInfo;
+void MediaEntry::addUser(std::string&& user) {
+    m_users.push_back(std::move(user));
 }
 
-void MediaEntry::setUserInfo(UserInfo&& userInfo){
-    using std::swap;
-    swap(m_userInfo, userInfo);
-    
-    UserInfo temp{};
-    swap(userInfo, temp);
+void MediaEntry::setUserInfo(const UserInfo& userInfo) {
+    m_userInfo = makeUserHandle(userInfo);
+}
+
+void MediaEntry::setUserInfo(UserInfo&& userInfo) {
+    m_userInfo = makeUserHandle(std::move(userInfo));
+}
+
+void MediaEntry::setUserInfo(UserHandle userInfo) {
+    m_userInfo = std::move(userInfo);
 }
 
 void swap(MediaEntry& media1, MediaEntry& media2){
@@ -0,0 +1,133 @@
+#include "MediaEntryView.h"
+
+namespace Instagram {
+
+MediaType MediaEntryView::type() const noexcept {
+    return m_mediaType;
+}
+
+std::string_view MediaEntryView::link() const noexcept {
+    return m_link;
+}
+
+std::string_view MediaEntryView::id() const noexcept {
+    return m_id;
+}
+
+std::string_view MediaEntryView::caption() const noexcept {
+    return m_caption;
+}
+
+std::string_view MediaEntryView::standartResolution() const noexcept {
+    return m_standartResolution;
+}
+
+std::string_view MediaEntryView::thumbnail() const noexcept {
+    return m_thumbnail;
+}
+
+std::string_view MediaEntryView::lowResolution() const noexcept {
+    return m_lowResolution;
+}
+
+std::string_view MediaEntryView::filter() const noexcept {
+    return m_filter;
+}
+
+std::string_view MediaEntryView::videoLowResolution() const noexcept {
+    return m_videoLow;
+}
+
+std::string_view MediaEntryView::videoStandartResolution() const noexcept {
+    return m_videoStandart;
+}
+
+const std::vector<std::string_view>& MediaEntryView::tags() const noexcept {
+    return m_tags;
+}
+
+const std::vector<std::string_view>& MediaEntryView::usersInPhoto() const noexcept {
+    return m_users;
+}
+
+const UserInfoView& MediaEntryView::userInfo() const noexcept {
+    return m_userInfo;
+}
+
+int MediaEntryView::commentsCount() const noexcept {
+    return m_commentsCount;
+}
+
+int MediaEntryView::likesCount() const noexcept {
+    return m_likesCount;
+}
+
+long MediaEntryView::createTime() const noexcept {
+    return m_createTime;
+}
+
+void MediaEntryView::setType(MediaType type) {
+    m_mediaType = type;
+}
+
+void MediaEntryView::setLink(std::string_view link) {
+    m_link = link;
+}
+
+void MediaEntryView::setId(std::string_view id) {
+    m_id = id;
+}
+
+void MediaEntryView::setCaption(std::string_view caption) {
+    m_caption = caption;
+}
+
+void MediaEntryView::setStandartResolution(std::string_view url) {
+    m_standartResolution = url;
+}
+
+void MediaEntryView::setThumbnail(std::string_view url) {
+    m_thumbnail = url;
+}
+
+void MediaEntryView::setLowResolution(std::string_view url) {
+    m_lowResolution = url;
+}
+
+void MediaEntryView::setFilter(std::string_view filter) {
+    m_filter = filter;
+}
+
+void MediaEntryView::setVideoLowResolution(std::string_view url) {
+    m_videoLow = url;
+}
+
+void MediaEntryView::setVideoStandartResolution(std::string_view url) {
+    m_videoStandart = url;
+}
+
+void MediaEntryView::setCommentsCount(int count) {
+    m_commentsCount = count;
+}
+
+void MediaEntryView::setLikeCount(int count) {
+    m_likesCount = count;
+}
+
+void MediaEntryView::setCreateTime(long time) {
+    m_createTime = time;
+}
+
+void MediaEntryView::addTag(std::string_view tag) {
+    m_tags.push_back(tag);
+}
+
+void MediaEntryView::addUser(std::string_view userId) {
+    m_users.push_back(userId);
+}
+
+void MediaEntryView::setUserInfo(const UserInfoView& userInfo) {
+    m_userInfo = userInfo;
+}
+
+}
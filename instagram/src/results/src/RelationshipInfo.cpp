@@ -22,6 +22,21 @@ RelationshipInfo::RelationshipInfo(const std::string& errMsg) : BaseResult{errMs
 
 RelationshipInfo::~RelationshipInfo() {}
 
+RelationshipInfo& RelationshipInfo::operator=(const RelationshipInfo& relInfo) {
+    RelationshipInfo copy{relInfo};
+
+    swap(*this, copy);
+    return *this;
+}
+
+RelationshipInfo& RelationshipInfo::operator=(RelationshipInfo&& relInfo) {
+    swap(*this, relInfo);
+
+    RelationshipInfo temp{};
+    swap(relInfo, temp);
+    return *this;
+}
+
 const std::string& RelationshipInfo::incomingStatus() const noexcept {
     return m_incomingStatus;
 }
@@ -34,10 +49,18 @@ void RelationshipInfo::setIncomingStatus(const std::string& status) {
     m_incomingStatus = status;
 }
 
+void RelationshipInfo::setIncomingStatus(std::string&& status) {
+    m_incomingStatus = std::move(status);
+}
+
 void RelationshipInfo::setOutgoingStatus(const std::string& status) {
     m_outgoingStatus = status;
 }
 
+void RelationshipInfo::setOutgoingStatus(std::string&& status) {
+    m_outgoingStatus = std::move(status);
+}
+
 void swap(RelationshipInfo& first, RelationshipInfo& second){
     using std::swap;
     swap(static_cast<BaseResult&>(first), static_cast<BaseResult&>(second));
@@ -45,6 +45,10 @@ void TagInfo::setName(const std::string& name) {
     m_name = name;
 }
 
+void TagInfo::setName(std::string&& name) {
+    m_name = std::move(name);
+}
+
 void TagInfo::setCount(int count) {
     m_count = count;
 }
@@ -81,26 +81,50 @@ void UserInfo::setId(const std::string& id) {
     m_id = id;
 }
 
+void UserInfo::setId(std::string&& id) {
+    m_id = std::move(id);
+}
+
 void UserInfo::setUsername(const std::string& username) {
     m_username = username;
 }
 
+void UserInfo::setUsername(std::string&& username) {
+    m_username = std::move(username);
+}
+
 void UserInfo::setFullName(const std::string& name) {
     m_fullName = name;
 }
 
+void UserInfo::setFullName(std::string&& name) {
+    m_fullName = std::move(name);
+}
+
 void UserInfo::setBio(const std::string& bio) {
     m_bio = bio;
 }
 
+void UserInfo::setBio(std::string&& bio) {
+    m_bio = std::move(bio);
+}
+
 void UserInfo::setProfilePictureUrl(const std::string& profPicUrl) {
     m_profPicUrl = profPicUrl;
 }
 
+void UserInfo::setProfilePictureUrl(std::string&& profPicUrl) {
+    m_profPicUrl = std::move(profPicUrl);
+}
+
 void UserInfo::setWebsite(const std::string& website) {
     m_website = website;
 }
 
+void UserInfo::setWebsite(std::string&& website) {
+    m_website = std::move(website);
+}
+
 void UserInfo::setFollowedBy(int count) {
     m_followedBy = count;
 }
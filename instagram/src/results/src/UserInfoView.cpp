@@ -0,0 +1,77 @@
+#include "UserInfoView.h"
+
+namespace Instagram {
+
+std::string_view UserInfoView::id() const noexcept {
+    return m_id;
+}
+
+std::string_view UserInfoView::username() const noexcept {
+    return m_username;
+}
+
+std::string_view UserInfoView::fullName() const noexcept {
+    return m_fullName;
+}
+
+std::string_view UserInfoView::bio() const noexcept {
+    return m_bio;
+}
+
+std::string_view UserInfoView::profilePictureUrl() const noexcept {
+    return m_profPicUrl;
+}
+
+std::string_view UserInfoView::website() const noexcept {
+    return m_website;
+}
+
+int UserInfoView::followedBy() const noexcept {
+    return m_followedBy;
+}
+
+int UserInfoView::follows() const noexcept {
+    return m_follows;
+}
+
+int UserInfoView::mediaCount() const noexcept {
+    return m_mediaCount;
+}
+
+void UserInfoView::setId(std::string_view id) {
+    m_id = id;
+}
+
+void UserInfoView::setUsername(std::string_view username) {
+    m_username = username;
+}
+
+void UserInfoView::setFullName(std::string_view name) {
+    m_fullName = name;
+}
+
+void UserInfoView::setBio(std::string_view bio) {
+    m_bio = bio;
+}
+
+void UserInfoView::setProfilePictureUrl(std::string_view profPicUrl) {
+    m_profPicUrl = profPicUrl;
+}
+
+void UserInfoView::setWebsite(std::string_view website) {
+    m_website = website;
+}
+
+void UserInfoView::setFollowedBy(int count) {
+    m_followedBy = count;
+}
+
+void UserInfoView::setFollows(int count) {
+    m_follows = count;
+}
+
+void UserInfoView::setMediaCount(int count) {
+    m_mediaCount = count;
+}
+
+}
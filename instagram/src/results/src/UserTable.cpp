@@ -0,0 +1,35 @@
+#include "UserTable.h"
+
+namespace Instagram {
+
+UserHandle makeUserHandle(const UserInfo& userInfo) {
+    return std::make_shared<UserInfo>(userInfo);
+}
+
+UserHandle makeUserHandle(UserInfo&& userInfo) {
+    return std::make_shared<UserInfo>(std::move(userInfo));
+}
+
+UserHandle UserTable::intern(UserInfo&& userInfo) {
+    if (userInfo.id().empty()) {
+        return makeUserHandle(std::move(userInfo));
+    }
+
+    auto it = m_users.find(userInfo.id());
+    if (it != m_users.end()) {
+        return it->second;
+    }
+
+    UserHandle handle = makeUserHandle(std::move(userInfo));
+    m_users.emplace(handle->id(), handle);
+    return handle;
+}
+
+UserHandle UserTable::intern(const UserHandle& userInfo) {
+    if (!userInfo || userInfo->id().empty()) {
+        return userInfo;
+    }
+    return m_users.emplace(userInfo->id(), userInfo).first->second;
+}
+
+}
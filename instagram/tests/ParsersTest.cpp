@@ -0,0 +1,231 @@
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include "Check.hpp"
+#include "InstagramParsers.h"
+
+// Checks the parser backend the library was built with against the responses
+// in fixtures/, both backends have to pass the same checks.
+
+using namespace Instagram;
+
+namespace {
+
+std::string fixturesDir{};
+
+std::string fixture(const std::string& name){
+    std::ifstream file{fixturesDir + "/" + name};
+    std::stringstream content;
+    content << file.rdbuf();
+    return content.str();
+}
+
+template<typename Page>
+void checkMediaEntries(const Page& media){
+    CHECK(media.succeed());
+    CHECK(media.size() == 2);
+    CHECK(media.nextUrl() == "https://api.instagram.com/v1/tags/NYC/media/recent?access_token=token&max_tag_id=1076191872211231");
+    CHECK(media.nextMaxId() == "1076191872211231");
+    if(media.size() != 2){
+        return;
+    }
+
+    const auto& image = media[0];
+    CHECK(image.id() == "22699663");
+    CHECK(image.type() == MediaType::IMAGE);
+    CHECK(image.link() == "http://instagr.am/p/BWrVZ/");
+    CHECK(image.filter() == "Earlybird");
+    CHECK(image.caption() == "Snow \"day\" in caf\xc3\xa9");
+    CHECK(image.createTime() == 1296703536);
+    CHECK(image.commentsCount() == 2);
+    CHECK(image.likesCount() == 15);
+    CHECK(image.lowResolution() == "http://distillery.s3.amazonaws.com/media/2011/02/02/low.jpg");
+    CHECK(image.thumbnail() == "http://distillery.s3.amazonaws.com/media/2011/02/02/thumb.jpg");
+    CHECK(image.standartResolution() == "http://distillery.s3.amazonaws.com/media/2011/02/02/standard.jpg");
+    CHECK(image.tags().size() == 2 && image.tags()[0] == "snow" && image.tags()[1] == "NYC");
+    CHECK(image.usersInPhoto().size() == 1 && image.usersInPhoto()[0] == "1574083");
+    CHECK(image.userInfo().id() == "1574083");
+    CHECK(image.userInfo().username() == "snoopdogg");
+    CHECK(image.userInfo().fullName() == "Snoop Dogg");
+
+    const auto& video = media[1];
+    CHECK(video.id() == "363839373298");
+    CHECK(video.type() == MediaType::VIDEO);
+    CHECK(video.caption().empty());
+    CHECK(video.tags().empty());
+    CHECK(video.videoLowResolution() == "http://distilleryvesper9-13.ak.instagram.com/low.mp4");
+    CHECK(video.videoStandartResolution() == "http://distilleryvesper9-13.ak.instagram.com/standard.mp4");
+
+    // entries of one page by the same author share it
+    CHECK(image.sharedUserInfo() && image.sharedUserInfo() == video.sharedUserInfo());
+}
+
+template<typename Page>
+void checkUsersInfo(const Page& users){
+    CHECK(users.succeed());
+    CHECK(users.size() == 2);
+    CHECK(users.nextMaxId() == "13872296");
+    if(users.size() != 2){
+        return;
+    }
+
+    CHECK(users[0].id() == "3");
+    CHECK(users[0].username() == "kevin");
+    CHECK(users[0].fullName() == "Kevin Systrom");
+    CHECK(users[0].mediaCount() == 1320);
+    CHECK(users[0].follows() == 420);
+    CHECK(users[0].followedBy() == 3410);
+    CHECK(users[1].id() == "25025320");
+    CHECK(users[1].follows() == -1);
+}
+
+void testMedia(){
+    checkMediaEntries(parseMediaEntries(fixture("media.json")));
+    checkMediaEntries(parseMediaEntries(fixture("media.json"), {}, makePageArena()));
+
+    const std::string json = fixture("media.json");
+    Http::StringBodySource body{json};
+    checkMediaEntries(parseMediaEntries(body));
+    Http::StringBodySource arenaBody{json};
+    checkMediaEntries(parseMediaEntries(arenaBody, {}, makePageArena()));
+
+    const MediaEntries ids = parseMediaEntries(fixture("media.json"), MediaField::ID | MediaField::TYPE);
+    CHECK(ids.size() == 2);
+    if(ids.size() == 2){
+        CHECK(ids[0].id() == "22699663");
+        CHECK(ids[0].type() == MediaType::IMAGE);
+        CHECK(ids[0].link().empty());
+        CHECK(ids[0].commentsCount() == -1);
+        CHECK(ids[0].userInfo().id().empty());
+    }
+
+    const MediaEntryViews views = parseMediaEntryViews(fixture("media.json"));
+    CHECK(views.succeed());
+    CHECK(views.size() == 2);
+    if(views.size() == 2){
+        CHECK(views[0].id() == "22699663");
+        CHECK(views[0].caption() == "Snow \"day\" in caf\xc3\xa9");
+        CHECK(views[0].tags().size() == 2 && views[0].tags()[1] == "NYC");
+        CHECK(views[0].userInfo().username() == "snoopdogg");
+        CHECK(views[1].type() == MediaType::VIDEO);
+    }
+}
+
+void testUsers(){
+    checkUsersInfo(parseUsersInfo(fixture("users.json")));
+
+    const std::string json = fixture("users.json");
+    Http::StringBodySource body{json};
+    checkUsersInfo(parseUsersInfo(body, {}, makePageArena()));
+    checkUsersInfo(parseUsersInfo(fixture("users.json"), {}, makePageArena()));
+
+    const UserInfoViews views = parseUsersInfoViews(fixture("users.json"));
+    CHECK(views.size() == 2);
+    if(views.size() == 2){
+        CHECK(views[0].username() == "kevin");
+        CHECK(views[0].followedBy() == 3410);
+    }
+
+    const UserInfo user = parseUserInfo(fixture("user.json"));
+    CHECK(user.succeed());
+    CHECK(user.id() == "1574083");
+    CHECK(user.bio() == "This is my bio");
+    CHECK(user.website() == "http://snoopdogg.com");
+    CHECK(user.followedBy() == 3410);
+
+    const UserInfo masked = parseUserInfo(fixture("user.json"), UserField::USERNAME);
+    CHECK(masked.username() == "snoopdogg");
+    CHECK(masked.id().empty());
+    CHECK(masked.mediaCount() == -1);
+}
+
+template<typename Page>
+void checkComments(const Page& comments){
+    CHECK(comments.succeed());
+    CHECK(comments.size() == 2);
+    if(comments.size() == 2){
+        CHECK(comments[0].id() == "420");
+        CHECK(comments[0].text() == "Really amazing photo!");
+        CHECK(comments[0].createTime() == 1280780324);
+        CHECK(comments[0].userInfo().username() == "snoopdogg");
+        CHECK(comments[0].sharedUserInfo() == comments[1].sharedUserInfo());
+    }
+}
+
+template<typename Page>
+void checkTags(const Page& tags){
+    CHECK(tags.size() == 2);
+    if(tags.size() == 2){
+        CHECK(tags[1].name() == "snowyday");
+        CHECK(tags[1].count() == 3264);
+    }
+}
+
+template<typename Page>
+void checkLocations(const Page& locations){
+    CHECK(locations.size() == 2);
+    if(locations.size() == 2){
+        CHECK(locations[0].name() == "Eiffel Tower, Paris");
+        CHECK(std::abs(locations[1].longitude() - 2.2943401336669909) < 1e-9);
+    }
+}
+
+void testComments(){
+    checkComments(parseComments(fixture("comments.json")));
+    checkComments(parseComments(fixture("comments.json"), makePageArena()));
+}
+
+void testTagsAndLocations(){
+    const TagInfo tag = parseTagInfo(fixture("tag.json"));
+    CHECK(tag.name() == "nofilter");
+    CHECK(tag.count() == 472);
+
+    checkTags(parseTagsInfo(fixture("tags.json")));
+    checkTags(parseTagsInfo(fixture("tags.json"), makePageArena()));
+
+    const LocationInfo location = parseLocation(fixture("location.json"));
+    CHECK(location.id() == "1");
+    CHECK(location.name() == "Dogpatch Labs");
+    CHECK(std::abs(location.latitude() - 37.782) < 1e-9);
+    CHECK(std::abs(location.longitude() + 122.387) < 1e-9);
+
+    checkLocations(parseLocations(fixture("locations.json")));
+    checkLocations(parseLocations(fixture("locations.json"), makePageArena()));
+}
+
+void testOthers(){
+    const RelationshipInfo relationship = parseRelationshipInfo(fixture("relationship.json"));
+    CHECK(relationship.incomingStatus() == "requested_by");
+    CHECK(relationship.outgoingStatus() == "none");
+
+    const AuthorizationToken token = parseAuthToken(fixture("token.json"));
+    CHECK(token.token() == "fb2e77d.47a0479900504cb3ab4a1f626d174d2d");
+    CHECK(token.userInfo().username() == "snoopdogg");
+
+    CHECK(getError(fixture("error.json")) == "400 : OAuthParameterException - The access_token provided is invalid.");
+    CHECK(getError(fixture("oauth_error.json")) == "400 : OAuthException - Matching code was not found or was already used.");
+    CHECK(getError(fixture("tag.json")) == " Call was successful");
+
+    CHECK(!parseMediaEntries("{\"data\": [").succeed());
+    CHECK(!parseUsersInfo("not json").succeed());
+}
+
+}
+
+int main(int argc, char** argv){
+    if(argc < 2){
+        std::cerr << "usage: " << argv[0] << " <fixtures dir>" << std::endl;
+        return 2;
+    }
+    fixturesDir = argv[1];
+
+    testMedia();
+    testUsers();
+    testComments();
+    testTagsAndLocations();
+    testOthers();
+
+    return Tests::checkResult();
+}
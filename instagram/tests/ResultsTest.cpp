@@ -0,0 +1,261 @@
+#include <algorithm>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include "Check.hpp"
+#include "ArenaCommentsInfo.h"
+#include "ArenaLocationsInfo.h"
+#include "ArenaMediaEntries.h"
+#include "ArenaTagsInfo.h"
+#include "ArenaUsersInfo.h"
+#include "MediaEntries.h"
+
+// Results and authors taken out of an arena page have to stay valid once the
+// page and its arena are gone. The arena here lives in a buffer that is overwritten after the
+// page is destroyed, anything still pointing into it reads garbage.
+
+using namespace Instagram;
+
+namespace {
+
+const std::string LINK{"http://distillery.s3.amazonaws.com/media/2011/02/02/standard.jpg"};
+const std::string TEXT{"longer than any small string buffer"};
+const std::string USER_ID{"1574083157408315740831574083"};
+
+class PoisonedArena{
+public:
+    PageArena arena(){
+        return std::make_shared<std::pmr::monotonic_buffer_resource>(m_buffer.data(), m_buffer.size(), std::pmr::null_memory_resource());
+    }
+
+    void poison(){
+        std::fill(m_buffer.begin(), m_buffer.end(), 'x');
+    }
+private:
+    std::vector<char> m_buffer = std::vector<char>(64 * 1024);
+};
+
+bool onHeap(const ResultAllocator& allocator){
+    return allocator.resource() == std::pmr::get_default_resource();
+}
+
+void testMediaMovedOutOfPage(){
+    PoisonedArena buffer{};
+    std::vector<ArenaMediaEntry> moved{};
+    {
+        ArenaMediaEntries page{buffer.arena()};
+        for(int i = 0; i < 3; ++i){
+            ArenaMediaEntry media{page.get_allocator()};
+            media.setLink(LINK);
+            media.addTag(TEXT);
+            ArenaUserInfo user{};
+            user.setId(USER_ID);
+            media.setUserInfo(std::move(user));
+            page << std::move(media);
+        }
+
+        moved.push_back(std::move(page[0]));
+        moved.emplace_back(std::move(page[1]), ResultAllocator{});
+
+        // within the page a move still hands the strings over
+        ArenaMediaEntry inPage{std::move(page[2]), page.get_allocator()};
+        CHECK(inPage.link() == LINK);
+        CHECK(page[2].link().empty());
+    }
+    buffer.poison();
+
+    for(const ArenaMediaEntry& media : moved){
+        CHECK(onHeap(media.get_allocator()));
+        CHECK(media.link() == LINK);
+        CHECK(media.tags().size() == 1 && std::string_view{media.tags()[0]} == TEXT);
+        CHECK(media.userInfo().id() == USER_ID);
+    }
+}
+
+void testUsersMovedOutOfPage(){
+    PoisonedArena buffer{};
+    std::vector<ArenaUserInfo> moved{};
+    {
+        ArenaUsersInfo page{buffer.arena()};
+        ArenaUserInfo user{page.get_allocator()};
+        user.setId(USER_ID);
+        user.setBio(TEXT);
+        page << std::move(user);
+
+        moved.push_back(std::move(page[0]));
+    }
+    buffer.poison();
+
+    CHECK(onHeap(moved[0].get_allocator()));
+    CHECK(moved[0].id() == USER_ID);
+    CHECK(moved[0].bio() == TEXT);
+}
+
+void testCommentsMovedOutOfPage(){
+    PoisonedArena buffer{};
+    std::vector<ArenaCommentInfo> moved{};
+    {
+        ArenaCommentsInfo page{buffer.arena()};
+        ArenaCommentInfo comment{page.get_allocator()};
+        comment.setText(TEXT);
+        ArenaUserInfo user{};
+        user.setId(USER_ID);
+        comment.setUserInfo(std::move(user));
+        page << std::move(comment);
+
+        moved.push_back(std::move(page[0]));
+    }
+    buffer.poison();
+
+    CHECK(onHeap(moved[0].get_allocator()));
+    CHECK(moved[0].text() == TEXT);
+    CHECK(moved[0].userInfo().id() == USER_ID);
+}
+
+void testTagsAndLocationsMovedOutOfPage(){
+    PoisonedArena tagsBuffer{};
+    PoisonedArena locationsBuffer{};
+    std::vector<ArenaTagInfo> tags{};
+    std::vector<ArenaLocationInfo> locations{};
+    {
+        ArenaTagsInfo tagsPage{tagsBuffer.arena()};
+        ArenaTagInfo tag{tagsPage.get_allocator()};
+        tag.setName(TEXT);
+        tagsPage << std::move(tag);
+        tags.push_back(std::move(tagsPage[0]));
+
+        ArenaLocationsInfo locationsPage{locationsBuffer.arena()};
+        ArenaLocationInfo location{locationsPage.get_allocator()};
+        location.setName(TEXT);
+        locationsPage << std::move(location);
+        locations.push_back(std::move(locationsPage[0]));
+    }
+    tagsBuffer.poison();
+    locationsBuffer.poison();
+
+    CHECK(tags[0].name() == TEXT);
+    CHECK(locations[0].name() == TEXT);
+}
+
+ArenaMediaEntries pageByOneAuthor(PageArena arena){
+    ArenaMediaEntries page{std::move(arena)};
+    ArenaUserTable users{page.arena()};
+    for(int i = 0; i < 3; ++i){
+        ArenaMediaEntry media{page.get_allocator()};
+        media.setLink(LINK);
+        ArenaUserInfo user{};
+        user.setId(USER_ID);
+        user.setBio(TEXT);
+        media.setUserInfo(users.intern(std::move(user)));
+        page << std::move(media);
+    }
+    return page;
+}
+
+void testAuthorOutlivesPage(){
+    PageArena arena = makePageArena();
+    std::weak_ptr<std::pmr::memory_resource> watch = arena;
+
+    ArenaUserHandle author{};
+    {
+        ArenaMediaEntries page = pageByOneAuthor(std::move(arena));
+        author = page[0].sharedUserInfo();
+    }
+
+    // the handle holds on to the arena its user lives in
+    CHECK(!watch.expired());
+    CHECK(author->id() == USER_ID);
+    CHECK(author->bio() == TEXT);
+
+    author.reset();
+    CHECK(watch.expired());
+}
+
+void testPageCopiedToHeap(){
+    PoisonedArena buffer{};
+    ArenaMediaEntries copy{};
+    ArenaMediaEntries assigned{};
+    {
+        const ArenaMediaEntries page = pageByOneAuthor(buffer.arena());
+        CHECK(page[0].sharedUserInfo() == page[2].sharedUserInfo());
+
+        copy = ArenaMediaEntries{page};
+        assigned = page;
+    }
+    buffer.poison();
+
+    for(const ArenaMediaEntries* heapPage : {&copy, &assigned}){
+        CHECK(heapPage->size() == 3);
+        if(heapPage->size() != 3){
+            continue;
+        }
+        const ArenaUserHandle& author = (*heapPage)[0].sharedUserInfo();
+        CHECK(author && onHeap(author->get_allocator()));
+        CHECK(author->bio() == TEXT);
+        CHECK((*heapPage)[1].sharedUserInfo() == author);
+        CHECK((*heapPage)[2].sharedUserInfo() == author);
+    }
+}
+
+void testUserSetByValue(){
+    PoisonedArena buffer{};
+    ArenaUserHandle author{};
+    {
+        ArenaMediaEntries page{buffer.arena()};
+        ArenaMediaEntry media{page.get_allocator()};
+        ArenaUserInfo user{page.get_allocator()};
+        user.setId(USER_ID);
+        media.setUserInfo(std::move(user));
+        author = media.sharedUserInfo();
+    }
+    buffer.poison();
+
+    CHECK(onHeap(author->get_allocator()));
+    CHECK(author->id() == USER_ID);
+}
+
+// heap pages keep the std::string interface of the results
+void testHeapPage(){
+    static_assert(std::is_same<decltype(std::declval<const MediaEntry&>().link()), const std::string&>::value, "");
+    static_assert(std::is_same<MediaEntries::container_type, std::vector<MediaEntry>>::value, "");
+
+    MediaEntries page{};
+    UserTable users{};
+    for(int i = 0; i < 2; ++i){
+        MediaEntry media{};
+        std::string link{LINK};
+        media.setLink(std::move(link));
+        media.addTag(TEXT);
+        UserInfo user{};
+        user.setId(USER_ID);
+        media.setUserInfo(users.intern(std::move(user)));
+        page << std::move(media);
+    }
+
+    const MediaEntries copy{page};
+    CHECK(copy.size() == 2);
+    if(copy.size() == 2){
+        CHECK(copy[0].link() == LINK);
+        CHECK(copy[0].tags() == std::vector<std::string>{TEXT});
+        CHECK(copy[0].sharedUserInfo() == copy[1].sharedUserInfo());
+        CHECK(copy[0].userInfo().id() == USER_ID);
+    }
+}
+
+}
+
+int main(){
+    testMediaMovedOutOfPage();
+    testUsersMovedOutOfPage();
+    testCommentsMovedOutOfPage();
+    testTagsAndLocationsMovedOutOfPage();
+    testAuthorOutlivesPage();
+    testPageCopiedToHeap();
+    testUserSetByValue();
+    testHeapPage();
+
+    return Tests::checkResult();
+}
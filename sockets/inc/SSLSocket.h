@@ -19,6 +19,7 @@ namespace Socket{
 
         long write(const void *data, size_t len) override;
         long read(void *buf, size_t len) override;
+        bool isAlive() const override;
 
         void close() override;
     private:
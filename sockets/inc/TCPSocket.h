@@ -5,11 +5,25 @@
 #ifndef FOLLOGRAPH_TCPSOCKET_H
 #define FOLLOGRAPH_TCPSOCKET_H
 
+#include <chrono>
 #include <string>
+#include <vector>
 
 namespace Socket{
 
     enum class Error{WOULDBLOCK, INTERRUPTED, PIPE_BROKEN, UNKNOWN};
+    enum class PeerState{IDLE, READABLE, CLOSED};
+
+    // Monotonic timestamps taken while the connection was set up, secured is
+    // left default-constructed for plain TCP sockets.
+    struct ConnectTimings{
+        using Clock = std::chrono::steady_clock;
+
+        Clock::time_point start{};
+        Clock::time_point resolved{};
+        Clock::time_point connected{};
+        Clock::time_point secured{};
+    };
     
     class TCPSocket{
         friend class ConnectionListener;
@@ -25,16 +39,24 @@ namespace Socket{
         virtual long read(void *data, size_t length);
         virtual void close();
         std::string ip() const;
+        const ConnectTimings& connectTimings() const noexcept;
 
         virtual void makeNonBlocking();
         virtual bool waitForRead(unsigned int timeout) const;
         virtual bool waitForWrite(unsigned int timeout) const;
+        virtual bool isAlive() const;
+
+        // Index of the first socket with data to read, -1 on timeout.
+        static int waitForAnyRead(const std::vector<const TCPSocket*>& sockets, std::chrono::milliseconds timeout);
 
         virtual Error lastError() const;
         virtual std::string lastErrorString() const;
     protected:
+        PeerState peerState() const;
+
         int m_sockfd = -1;
         bool m_isBlocking = true;
+        ConnectTimings m_connectTimings{};
     private:
         TCPSocket(int sockfd, bool isBlocking);
         void connect(const std::string& host, const std::string& port);
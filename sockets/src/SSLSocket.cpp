@@ -1,5 +1,7 @@
 #include <stdexcept>
 #include <memory>
+#include <mutex>
+#include <vector>
 #include <openssl/err.h>
 #include <openssl/x509v3.h>
 #include "SSLSocket.h"
@@ -7,11 +9,32 @@
 namespace Socket {
     [[noreturn]] inline void throwSslError();
 
+#if OPENSSL_VERSION_NUMBER < 0x10100000L
+    // OpenSSL before 1.1 is only safe to use from several threads once it is
+    // given locks to work with
+    static std::vector<std::mutex>& sslLocks(){
+        static std::vector<std::mutex> locks(static_cast<size_t>(CRYPTO_num_locks()));
+        return locks;
+    }
+
+    static void sslLockingCallback(int mode, int n, const char*, int){
+        if(mode & CRYPTO_LOCK){
+            sslLocks()[static_cast<size_t>(n)].lock();
+        }else{
+            sslLocks()[static_cast<size_t>(n)].unlock();
+        }
+    }
+#endif
+
     class SSLInit{
     public:        
         SSLInit(){
             SSL_load_error_strings();
             SSL_library_init();
+#if OPENSSL_VERSION_NUMBER < 0x10100000L
+            sslLocks();
+            CRYPTO_set_locking_callback(sslLockingCallback);
+#endif
         }
 
         ~SSLInit(){
@@ -78,6 +101,8 @@ namespace Socket {
         if(SSL_connect(m_ssl) != 1){
             throwSslError();
         }
+
+        m_connectTimings.secured = ConnectTimings::Clock::now();
     }
 
     long SSLSocket::write(const void *data, size_t len) {
@@ -90,6 +115,23 @@ namespace Socket {
         return count;
     }
 
+    bool SSLSocket::isAlive() const {
+        switch (peerState()) {
+            case PeerState::IDLE:
+                return true;
+            case PeerState::CLOSED:
+                return false;
+            case PeerState::READABLE:
+                break;
+        }
+
+        // TLS 1.3 servers send session tickets after the handshake, so pending
+        // bytes on an idle connection are not necessarily application data.
+        char byte;
+        int count = SSL_peek(m_ssl, &byte, 1);
+        return count <= 0 && SSL_get_error(m_ssl, count) == SSL_ERROR_WANT_READ;
+    }
+
     void SSLSocket::close() {
         SSL_free(m_ssl);
         SSL_CTX_free(m_ctx);
@@ -16,6 +16,10 @@ TCPSocket::~TCPSocket() {
     TCPSocket::close();
 }
 
+const ConnectTimings& TCPSocket::connectTimings() const noexcept {
+    return m_connectTimings;
+}
+
 TCPSocket &TCPSocket::operator=(TCPSocket &&tcpSocket) {
     m_sockfd = -1;
     m_isBlocking = false;
@@ -28,6 +32,7 @@ void swap(TCPSocket& sock1, TCPSocket& sock2){
     using std::swap;
     swap(sock1.m_sockfd, sock2.m_sockfd);
     swap(sock1.m_isBlocking, sock2.m_isBlocking);
+    swap(sock1.m_connectTimings, sock2.m_connectTimings);
 }
 
 }
@@ -26,10 +26,15 @@ void TCPSocket::connect(const std::string& host, const std::string& port) {
     hints.ai_socktype = SOCK_STREAM;
     hints.ai_family = AF_UNSPEC;
 
+    m_connectTimings = ConnectTimings{};
+    m_connectTimings.start = ConnectTimings::Clock::now();
+
     if (getaddrinfo(host.c_str(), port.c_str(), &hints, &res) != 0) {
         throwError("getaddrinfo() failed", lastErrorCode());
     }
 
+    m_connectTimings.resolved = ConnectTimings::Clock::now();
+
     for (addrinfo* tmp_res = res; tmp_res != nullptr; tmp_res = res->ai_next) {
         m_sockfd = socket(tmp_res->ai_family, tmp_res->ai_socktype, tmp_res->ai_protocol);
 
@@ -49,6 +54,8 @@ void TCPSocket::connect(const std::string& host, const std::string& port) {
     if (m_sockfd == -1) {
         throwError("failed to create socket", lastErrorCode());
     }
+
+    m_connectTimings.connected = ConnectTimings::Clock::now();
 }
 
 long TCPSocket::write(const void *data, size_t length) {
@@ -56,7 +63,7 @@ long TCPSocket::write(const void *data, size_t length) {
         throw std::runtime_error("not connected");
     }
 
-    long count = send(m_sockfd, data, length, 0);
+    long count = send(m_sockfd, data, length, MSG_NOSIGNAL);
 
     return count;
 }
@@ -151,6 +158,58 @@ bool TCPSocket::waitForWrite(unsigned int timeout) const {
 
 }
 
+int TCPSocket::waitForAnyRead(const std::vector<const TCPSocket*>& sockets, std::chrono::milliseconds timeout) {
+    std::vector<pollfd> pfds(sockets.size());
+    for (size_t i = 0; i < sockets.size(); ++i) {
+        pfds[i].fd = sockets[i]->m_sockfd;
+        pfds[i].events = POLLIN;
+        pfds[i].revents = 0;
+    }
+
+    int result = poll(pfds.data(), static_cast<nfds_t>(pfds.size()), static_cast<int>(timeout.count()));
+    if (result > 0) {
+        for (size_t i = 0; i < pfds.size(); ++i) {
+            if (pfds[i].revents) {
+                return static_cast<int>(i);
+            }
+        }
+    }
+
+    return -1;
+}
+
+bool TCPSocket::isAlive() const {
+    return peerState() == PeerState::IDLE;
+}
+
+PeerState TCPSocket::peerState() const {
+    if (m_sockfd == -1) {
+        return PeerState::CLOSED;
+    }
+
+    pollfd pfd;
+    pfd.fd = m_sockfd;
+    pfd.events = POLLIN | POLLRDHUP;
+    pfd.revents = 0;
+
+    int result = poll(&pfd, 1, 0);
+    if (result == 0) {
+        return PeerState::IDLE;
+    }
+
+    if (result < 0 || (pfd.revents & (POLLERR | POLLHUP | POLLRDHUP | POLLNVAL))) {
+        return PeerState::CLOSED;
+    }
+
+    char byte;
+    long count = recv(m_sockfd, &byte, 1, MSG_PEEK | MSG_DONTWAIT);
+    if (count > 0) {
+        return PeerState::READABLE;
+    }
+
+    return (count < 0 && (errno == EWOULDBLOCK || errno == EAGAIN || errno == EINTR)) ? PeerState::IDLE : PeerState::CLOSED;
+}
+
 Error TCPSocket::lastError() const {
     switch (lastErrorCode()) {
     case EWOULDBLOCK:
@@ -26,6 +26,9 @@ void TCPSocket::connect(const std::string& host, const std::string& port) {
     hints.ai_socktype = SOCK_STREAM;
     hints.ai_family = AF_UNSPEC;
 
+    m_connectTimings = ConnectTimings{};
+    m_connectTimings.start = ConnectTimings::Clock::now();
+
     if (getaddrinfo(host.c_str(), port.c_str(), &hints, &res) != 0) {
         if (WSAGetLastError() == WSANOTINITIALISED) {
             int result = initWSA();
@@ -39,6 +42,8 @@ void TCPSocket::connect(const std::string& host, const std::string& port) {
         }
     }
 
+    m_connectTimings.resolved = ConnectTimings::Clock::now();
+
     for (addrinfo* tmp_res = res; tmp_res != nullptr; tmp_res = res->ai_next) {
         m_sockfd = socket(tmp_res->ai_family, tmp_res->ai_socktype, tmp_res->ai_protocol);
 
@@ -57,6 +62,8 @@ void TCPSocket::connect(const std::string& host, const std::string& port) {
     if (m_sockfd == -1) {
         throwError("failed to create socket", lastErrorCode());
     }
+
+    m_connectTimings.connected = ConnectTimings::Clock::now();
 }
 
 long TCPSocket::write(const void *data, size_t length) {
@@ -157,6 +164,59 @@ bool TCPSocket::waitForWrite(unsigned int timeout) const {
     return result == SOCKET_ERROR ? false : result;
 }
 
+int TCPSocket::waitForAnyRead(const std::vector<const TCPSocket*>& sockets, std::chrono::milliseconds timeout) {
+    fd_set readfs{};
+    for (const TCPSocket* socket : sockets) {
+        readfs.fd_array[readfs.fd_count++] = socket->m_sockfd;
+    }
+
+    timeval time{};
+    time.tv_sec = static_cast<long>(timeout.count() / 1000);
+    time.tv_usec = static_cast<long>((timeout.count() % 1000) * 1000);
+
+    if (select(0, &readfs, nullptr, nullptr, &time) > 0) {
+        for (size_t i = 0; i < sockets.size(); ++i) {
+            if (FD_ISSET(sockets[i]->m_sockfd, &readfs)) {
+                return static_cast<int>(i);
+            }
+        }
+    }
+
+    return -1;
+}
+
+bool TCPSocket::isAlive() const {
+    return peerState() == PeerState::IDLE;
+}
+
+PeerState TCPSocket::peerState() const {
+    if (m_sockfd == -1) {
+        return PeerState::CLOSED;
+    }
+
+    fd_set readfs{};
+    readfs.fd_count = 1;
+    readfs.fd_array[0] = m_sockfd;
+
+    timeval time{};
+    int result = select(0, &readfs, nullptr, nullptr, &time);
+    if (result == 0) {
+        return PeerState::IDLE;
+    }
+
+    if (result == SOCKET_ERROR) {
+        return PeerState::CLOSED;
+    }
+
+    char byte;
+    int count = recv(m_sockfd, &byte, 1, MSG_PEEK);
+    if (count > 0) {
+        return PeerState::READABLE;
+    }
+
+    return (count == SOCKET_ERROR && WSAGetLastError() == WSAEWOULDBLOCK) ? PeerState::IDLE : PeerState::CLOSED;
+}
+
 Error TCPSocket::lastError() const {
     int code = lastErrorCode();
     switch (code) {